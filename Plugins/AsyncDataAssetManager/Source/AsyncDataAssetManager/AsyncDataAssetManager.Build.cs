@@ -40,6 +40,7 @@ public class AsyncDataAssetManager : ModuleRules
 				"SlateCore",
 				"DeveloperSettings",
 				"GameplayTags",
+				"AssetRegistry",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
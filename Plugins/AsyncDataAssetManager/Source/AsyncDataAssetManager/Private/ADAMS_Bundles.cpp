@@ -0,0 +1,190 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "AsyncDataAssetManagerSubsystem.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/DataAsset.h"
+#include "AsyncTechnologiesSettings.h"
+
+void UAsyncDataAssetManagerSubsystem::LoadPrimaryADAM(FPrimaryAssetId PrimaryAssetId, FTagADAM Tag, TArray<FName> Bundles, int32 RecursiveDepthLoading, TSoftObjectPtr<UPrimaryDataAsset>& ReturnPrimaryDataAsset, int32 Priority)
+{
+	FSoftObjectPath AssetPath = UAssetManager::Get().GetPrimaryAssetPath(PrimaryAssetId);
+
+	if (AssetPath.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Load Primary): Primary Asset \"%s\" is not known to the Asset Manager."), *PrimaryAssetId.ToString());
+
+		return;
+	}
+
+	// Stored data is not requested again, only its missing bundles are
+	bool bIsStored = DataADAM.FindSlot(AssetPath) != INDEX_NONE || CoolingADAM.Contains(AssetPath);
+	TArray<FName> AddedBundles = AddPrimaryBundlesADAM(PrimaryAssetId, AssetPath, Bundles);
+
+	LoadADAM(TSoftObjectPtr<UPrimaryDataAsset>(AssetPath), Tag, RecursiveDepthLoading, ReturnPrimaryDataAsset, Priority);
+
+	// Data requested together with its nested closure is loaded by a batch without the Asset Manager
+	FPrimaryBundlesADAM* PrimaryBundles = PrimaryBundlesADAM.Find(AssetPath);
+
+	if (PrimaryBundles && !AddedBundles.IsEmpty() && (bIsStored || !PrimaryBundles->IsRequested))
+	{
+		PrimaryBundles->IsRequested = true;
+		RequestBundleStateADAM(PrimaryAssetId, AddedBundles, TArray<FName>(), Priority);
+	}
+}
+
+int32 UAsyncDataAssetManagerSubsystem::LoadPrimaryArrayADAM(TArray<FPrimaryAssetId> PrimaryAssetIds, FTagADAM Tag, TArray<FName> Bundles, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& ReturnPrimaryDataAssets, int32 Priority)
+{
+	TArray<TSoftObjectPtr<UPrimaryDataAsset>> PrimaryDataAssets;
+	TArray<TPair<FPrimaryAssetId, TArray<FName>>> StoredBundles;
+
+	PrimaryDataAssets.Reserve(PrimaryAssetIds.Num());
+
+	for (const FPrimaryAssetId& PrimaryAssetId : PrimaryAssetIds)
+	{
+		FSoftObjectPath AssetPath = UAssetManager::Get().GetPrimaryAssetPath(PrimaryAssetId);
+
+		if (AssetPath.IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ADAM (Load Primary Array): Primary Asset \"%s\" is not known to the Asset Manager."), *PrimaryAssetId.ToString());
+
+			continue;
+		}
+
+		bool bIsStored = DataADAM.FindSlot(AssetPath) != INDEX_NONE || CoolingADAM.Contains(AssetPath);
+		TArray<FName> AddedBundles = AddPrimaryBundlesADAM(PrimaryAssetId, AssetPath, Bundles);
+
+		if (bIsStored && !AddedBundles.IsEmpty())
+		{
+			PrimaryBundlesADAM[AssetPath].IsRequested = true;
+			StoredBundles.Emplace(PrimaryAssetId, MoveTemp(AddedBundles));
+		}
+
+		PrimaryDataAssets.Add(TSoftObjectPtr<UPrimaryDataAsset>(AssetPath));
+	}
+
+	if (PrimaryDataAssets.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Load Primary Array): No known Primary Asset is specified in function."));
+
+		return 0;
+	}
+
+	int32 BatchId = LoadArrayADAM(PrimaryDataAssets, Tag, NotifyAfterFullLoaded, RecursiveDepthLoading, ReturnPrimaryDataAssets, Priority);
+
+	for (const TPair<FPrimaryAssetId, TArray<FName>>& Stored : StoredBundles)
+	{
+		RequestBundleStateADAM(Stored.Key, Stored.Value, TArray<FName>(), Priority);
+	}
+
+	// Data loaded by a batch doesn't go through the Asset Manager, so its bundles are requested separately
+	for (const TSoftObjectPtr<UPrimaryDataAsset>& DataAsset : PrimaryDataAssets)
+	{
+		FPrimaryBundlesADAM* PrimaryBundles = PrimaryBundlesADAM.Find(DataAsset.ToSoftObjectPath());
+
+		if (PrimaryBundles && !PrimaryBundles->IsRequested && !PrimaryBundles->Bundles.IsEmpty())
+		{
+			PrimaryBundles->IsRequested = true;
+			RequestBundleStateADAM(PrimaryBundles->PrimaryAssetId, PrimaryBundles->Bundles, TArray<FName>(), Priority);
+		}
+	}
+
+	return BatchId;
+}
+
+void UAsyncDataAssetManagerSubsystem::ChangeBundleStateADAM(FPrimaryAssetId PrimaryAssetId, TArray<FName> AddBundles, TArray<FName> RemoveBundles, int32 Priority)
+{
+	FSoftObjectPath AssetPath = UAssetManager::Get().GetPrimaryAssetPath(PrimaryAssetId);
+
+	if (AssetPath.IsNull() || DataADAM.FindSlot(AssetPath) == INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Change Bundle State): Primary Asset \"%s\" is not in the memory of the ADAM subsystem."), *PrimaryAssetId.ToString());
+
+		return;
+	}
+
+	TArray<FName> AddedBundles = AddPrimaryBundlesADAM(PrimaryAssetId, AssetPath, AddBundles);
+	FPrimaryBundlesADAM& PrimaryBundles = PrimaryBundlesADAM[AssetPath];
+
+	for (FName RemoveBundle : RemoveBundles)
+	{
+		PrimaryBundles.Bundles.Remove(RemoveBundle);
+	}
+
+	PrimaryBundles.IsRequested = true;
+
+	RequestBundleStateADAM(PrimaryAssetId, AddedBundles, RemoveBundles, Priority);
+}
+
+TArray<FName> UAsyncDataAssetManagerSubsystem::GetBundleStateADAM(FPrimaryAssetId PrimaryAssetId)
+{
+	const FPrimaryBundlesADAM* PrimaryBundles = PrimaryBundlesADAM.Find(UAssetManager::Get().GetPrimaryAssetPath(PrimaryAssetId));
+
+	return PrimaryBundles ? PrimaryBundles->Bundles : TArray<FName>();
+}
+
+TArray<FName> UAsyncDataAssetManagerSubsystem::AddPrimaryBundlesADAM(const FPrimaryAssetId& PrimaryAssetId, const FSoftObjectPath& AssetPath, const TArray<FName>& Bundles)
+{
+	FPrimaryBundlesADAM& PrimaryBundles = PrimaryBundlesADAM.FindOrAdd(AssetPath);
+	PrimaryBundles.PrimaryAssetId = PrimaryAssetId;
+
+	TArray<FName> AddedBundles;
+
+	for (FName Bundle : Bundles)
+	{
+		if (!Bundle.IsNone() && !PrimaryBundles.Bundles.Contains(Bundle))
+		{
+			PrimaryBundles.Bundles.Add(Bundle);
+			AddedBundles.Add(Bundle);
+		}
+	}
+
+	return AddedBundles;
+}
+
+void UAsyncDataAssetManagerSubsystem::RequestBundleStateADAM(const FPrimaryAssetId& PrimaryAssetId, const TArray<FName>& AddBundles, const TArray<FName>& RemoveBundles, int32 Priority)
+{
+	// The Asset Manager can complete the request right away, the notification is sent once either way
+	TSharedRef<bool> IsNotified = MakeShared<bool>(false);
+
+	FStreamableDelegate Delegate = FStreamableDelegate::CreateWeakLambda(this, [this, PrimaryAssetId, IsNotified]()
+	{
+		if (*IsNotified)
+			return;
+
+		*IsNotified = true;
+
+		// Inform the FOnBundleStateChangedADAM subsystem delegate that the bundles are loaded
+		OnBundleStateChangedADAM.Broadcast(PrimaryAssetId);
+	});
+
+	TArray<FPrimaryAssetId> PrimaryAssetIds;
+	PrimaryAssetIds.Add(PrimaryAssetId);
+
+	TSharedPtr<FStreamableHandle> BundleHandle = UAssetManager::Get().ChangeBundleStateForPrimaryAssets(PrimaryAssetIds, AddBundles, RemoveBundles, false, Delegate, Priority);
+
+	// Nothing to load
+	if (!BundleHandle.IsValid())
+	{
+		Delegate.ExecuteIfBound();
+	}
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Bundle State): %d bundles of Primary Asset \"%s\" are requested, %d are released."), AddBundles.Num(), *PrimaryAssetId.ToString(), RemoveBundles.Num());
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::ReleasePrimaryBundlesADAM(const FSoftObjectPath& AssetPath)
+{
+	FPrimaryBundlesADAM PrimaryBundles;
+
+	if (!PrimaryBundlesADAM.RemoveAndCopyValue(AssetPath, PrimaryBundles))
+		return;
+
+	// The Asset Manager releases the Primary Asset together with all its bundles
+	if (UAssetManager* AssetManager = UAssetManager::GetIfInitialized())
+	{
+		AssetManager->UnloadPrimaryAsset(PrimaryBundles.PrimaryAssetId);
+	}
+}
@@ -5,21 +5,29 @@
 #include "Engine/AssetManager.h"
 #include "Engine/DataAsset.h"
 #include "AsyncTechnologiesSettings.h"
+#include "NestedAssetsPlanADAM.h"
+#include "StatsADAM.h"
 
 TArray<FMirrorADAM> UAsyncDataAssetManagerSubsystem::GetDataADAM()
 {
-	int32 Length = DataADAM.Num();
+	SCOPE_CYCLE_COUNTER(STAT_GetDataADAM);
+
 	TArray<FMirrorADAM> MirrorDataADAM;
 
-	if (Length == 0) 
+	if (DataADAM.IsEmpty()) 
 		return MirrorDataADAM;
 
-	for (int32 i = 0; i < Length; i++)
+	MirrorDataADAM.Reserve(DataADAM.Num());
+
+	for (TConstSetBitIterator<> It = DataADAM.CreateConstIterator(); It; ++It)
 	{
+		int32 Slot = It.GetIndex();
+
 		FMirrorADAM MirrorDataAsset;
-		MirrorDataAsset.PrimaryDataAssetName = DataADAM[i].SoftReference.GetAssetName();
-		MirrorDataAsset.SoftReference = DataADAM[i].SoftReference;
-		MirrorDataAsset.Tag = DataADAM[i].Tag;
+		MirrorDataAsset.SoftReference = TSoftObjectPtr<UPrimaryDataAsset>(DataADAM.GetAssetPath(Slot));
+		MirrorDataAsset.PrimaryDataAssetName = MirrorDataAsset.SoftReference.GetAssetName();
+		MirrorDataAsset.Tag = DataADAM.GetTag(Slot);
+		MirrorDataAsset.Owners = DataADAM.GetOwners(Slot);
 		MirrorDataADAM.Add(MirrorDataAsset);
 	}
 
@@ -28,26 +36,30 @@ TArray<FMirrorADAM> UAsyncDataAssetManagerSubsystem::GetDataADAM()
 
 TMap<FName, int32> UAsyncDataAssetManagerSubsystem::GetCollectionByTagADAM()
 {
+	SCOPE_CYCLE_COUNTER(STAT_GetCollectionByTagADAM);
+
 	TMap<FName, int32> TagCollection;
 
-	if (DataADAM.Num() == 0) 
+	if (DataADAM.IsEmpty()) 
 		return TagCollection;
 
-	for (const FMemoryADAM& Data : DataADAM)
+	TagCollection.Reserve(DataADAM.GetTagBuckets().Num());
+
+	for (const TPair<FName, TSet<int32>>& TagBucket : DataADAM.GetTagBuckets())
 	{
-		if (TagCollection.Contains(Data.Tag))
-		{
-			TagCollection[Data.Tag]++;
-		}
-		else
-		{
-			TagCollection.Add(Data.Tag, 1);
-		}
+		TagCollection.Add(TagBucket.Key, TagBucket.Value.Num());
 	}
 
 	return TagCollection;
 }
 
+int32 UAsyncDataAssetManagerSubsystem::GetNumByTagADAM(FTagADAM Tag)
+{
+	const TSet<int32>* TagBucket = DataADAM.FindTagBucket(GetTagNameFromStruct(Tag));
+
+	return TagBucket ? TagBucket->Num() : 0;
+}
+
 UObject* UAsyncDataAssetManagerSubsystem::GetObjectDataADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, bool& IsValid )
 {
 	if (PrimaryDataAsset.IsNull())
@@ -66,23 +78,125 @@ UObject* UAsyncDataAssetManagerSubsystem::GetObjectDataADAM(TSoftObjectPtr<UPrim
 		return nullptr;
 	}
 
-	UObject* DataAsset = DataADAM[ObjectIndex].MemoryReference->GetLoadedAsset();
+	// Resolved once the post-load processing is done, a load that is not processed yet is resolved by its descriptor
+	UObject* DataAsset = DataADAM.GetLoadedAsset(ObjectIndex);
+
+	if (!DataAsset)
+	{
+		const TSharedPtr<FStreamableHandle>& DataAssetHandle = DataADAM.GetStreamableHandle(ObjectIndex);
+		DataAsset = GetStreamableAssetADAM(DataAssetHandle, DataADAM.GetAssetPath(ObjectIndex));
+	}
 
 	// Return bool value. Checking of Data Asset
 	IsValid = DataAsset != nullptr;
 
+	if (IsValid)
+	{
+		DataADAM.Touch(ObjectIndex);
+	}
+
 	return DataAsset;
 }
 
 int32 UAsyncDataAssetManagerSubsystem::GetIndexDataADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset)
 {
-	for (int32 i = 0; i < DataADAM.Num(); i++)
+	// Constant time search by asset path
+	return DataADAM.FindSlot(PrimaryDataAsset.ToSoftObjectPath());
+}
+
+FHandleADAM UAsyncDataAssetManagerSubsystem::GetHandleDataADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset)
+{
+	int32 TargetIndex = GetIndexDataADAM(PrimaryDataAsset);
+
+	if (TargetIndex != INDEX_NONE)
 	{
-		if (DataADAM[i].SoftReference == PrimaryDataAsset) 
-			return i;
+		DataADAM.Touch(TargetIndex);
 	}
 
-	return -1;
+	return DataADAM.GetHandle(TargetIndex);
+}
+
+bool UAsyncDataAssetManagerSubsystem::IsValidHandleADAM(FHandleADAM Handle)
+{
+	return DataADAM.IsValidHandle(Handle);
+}
+
+int32 UAsyncDataAssetManagerSubsystem::GetGenerationADAM()
+{
+	return DataADAM.GetGeneration();
+}
+
+int32 UAsyncDataAssetManagerSubsystem::GetTagGenerationADAM(FTagADAM Tag)
+{
+	return DataADAM.GetTagGeneration(GetTagNameFromStruct(Tag));
+}
+
+bool UAsyncDataAssetManagerSubsystem::IsLoadingADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset)
+{
+	return InFlightADAM.Contains(PrimaryDataAsset.ToSoftObjectPath());
+}
+
+bool UAsyncDataAssetManagerSubsystem::IsBatchLoadingADAM(int32 BatchId)
+{
+	return LoadBatchesADAM.Contains(BatchId);
+}
+
+bool UAsyncDataAssetManagerSubsystem::IsPreloadedADAM()
+{
+	return IsPreloaded;
+}
+
+float UAsyncDataAssetManagerSubsystem::GetBatchProgressADAM(int32 BatchId)
+{
+	const FLoadBatchADAM* LoadBatch = LoadBatchesADAM.Find(BatchId);
+
+	if (!LoadBatch)
+		return 1.0f;
+
+	int32 NumTotal = LoadBatch->NumCompleted + LoadBatch->PendingPaths.Num();
+
+	if (NumTotal == 0)
+		return 0.0f;
+
+	float LoadedProgress = LoadBatch->NumCompleted;
+
+	for (const FSoftObjectPath& DataAssetPath : LoadBatch->PendingPaths)
+	{
+		const FInFlightADAM* InFlight = InFlightADAM.Find(DataAssetPath);
+
+		// Loaded data waiting for post-load processing
+		if (!InFlight)
+		{
+			LoadedProgress += 1.0f;
+
+			continue;
+		}
+
+		// Data Assets of a batch share the progress of the batch descriptor
+		const TSharedPtr<FStreamableHandle>* BatchHandle = InFlight->BatchKey != 0 ? BatchHandlesADAM.Find(InFlight->BatchKey) : nullptr;
+		const TSharedPtr<FStreamableHandle>& StreamableHandle = BatchHandle ? *BatchHandle : InFlight->StreamableHandle;
+
+		if (StreamableHandle.IsValid())
+		{
+			LoadedProgress += StreamableHandle->GetProgress();
+		}
+	}
+
+	return LoadedProgress / NumTotal;
+}
+
+TArray<FName> UAsyncDataAssetManagerSubsystem::GetOwnersADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset)
+{
+	int32 TargetIndex = GetIndexDataADAM(PrimaryDataAsset);
+
+	return TargetIndex != INDEX_NONE ? DataADAM.GetOwners(TargetIndex) : TArray<FName>();
+}
+
+bool UAsyncDataAssetManagerSubsystem::IsOwnedByTagADAM(const FSoftObjectPath& AssetPath, FName Tag) const
+{
+	int32 TargetIndex = DataADAM.FindSlot(AssetPath);
+
+	return TargetIndex != INDEX_NONE && DataADAM.HasOwner(TargetIndex, Tag);
 }
 
 TArray<TSoftObjectPtr<UPrimaryDataAsset>> UAsyncDataAssetManagerSubsystem::FindNestedAssets(UPrimaryDataAsset* DataAsset)
@@ -96,10 +210,10 @@ TArray<TSoftObjectPtr<UPrimaryDataAsset>> UAsyncDataAssetManagerSubsystem::FindN
 	}
 
 	// Use a set for faster unique checks
-	TSet<FString> UniqueAssetNames;
+	TSet<FSoftObjectPath> UniqueAssetPaths;
 
 	// Start recursion from the DataAsset itself
-	FindNestedAssetsRecursive(DataAsset, DataAsset->GetClass(), NestedAssets, UniqueAssetNames);
+	FindNestedAssetsRecursive(DataAsset, DataAsset->GetClass(), NestedAssets, UniqueAssetPaths);
 
 	if (EnableLog && NestedAssets.Num() == 0)
 	{
@@ -109,79 +223,30 @@ TArray<TSoftObjectPtr<UPrimaryDataAsset>> UAsyncDataAssetManagerSubsystem::FindN
 	return NestedAssets;
 }
 
-void UAsyncDataAssetManagerSubsystem::FindNestedAssetsRecursive(void* Container, UStruct* Struct, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& OutNestedAssets, TSet<FString>& UniqueAssetNames)
+void UAsyncDataAssetManagerSubsystem::FindNestedAssetsRecursive(const void* Container, const UStruct* Struct, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& OutNestedAssets, TSet<FSoftObjectPath>& UniqueAssetPaths)
 {
+	SCOPE_CYCLE_COUNTER(STAT_FindNestedAssetsADAM);
+
 	if (!Container || !Struct) 
 		return;
 
-	// Iterate over all properties in the struct/class
-	for (TFieldIterator<FProperty> PropIterator(Struct); PropIterator; ++PropIterator)
-	{
-		const FProperty* Prop = *PropIterator;
-		// Handle soft object properties (TSoftObjectPtr<UPrimaryDataAsset>)
-		if (const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Prop))
-		{
-			if (SoftObjectProperty->PropertyClass->IsChildOf(UPrimaryDataAsset::StaticClass()))
-			{
-				TSoftObjectPtr<UPrimaryDataAsset> ChildAsset = *SoftObjectProperty->ContainerPtrToValuePtr<TSoftObjectPtr<UPrimaryDataAsset>>(Container);
-				FString ChildAssetName = ChildAsset.GetAssetName();
-				if (!ChildAssetName.IsEmpty() && !UniqueAssetNames.Contains(ChildAssetName))
-				{
-					UniqueAssetNames.Add(ChildAssetName);
-					OutNestedAssets.Add(ChildAsset);
-				}
-			}
-		}
-		// Handle struct properties (recurse into the struct)
-		else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Prop))
-		{
-			void* StructData = StructProperty->ContainerPtrToValuePtr<void>(Container);
-			if (StructData)
-			{
-				FindNestedAssetsRecursive(StructData, StructProperty->Struct, OutNestedAssets, UniqueAssetNames);
-			}
-		}
-		// Handle array properties
-		else if (const FArrayProperty* ArrayProp = CastField<FArrayProperty>(Prop))
-		{
-			FScriptArrayHelper ArrayHelper(ArrayProp, ArrayProp->ContainerPtrToValuePtr<void>(Container));
-			// Check inner property type
-			const FProperty* InnerProp = ArrayProp->Inner;
-			// If inner is soft object ptr
-			if (const FSoftObjectProperty* InnerSoftObjectProperty = CastField<FSoftObjectProperty>(InnerProp))
-			{
-				if (InnerSoftObjectProperty->PropertyClass->IsChildOf(UPrimaryDataAsset::StaticClass()))
-				{
-					for (int32 i = 0; i < ArrayHelper.Num(); ++i)
-					{
-						TSoftObjectPtr<UPrimaryDataAsset> ChildAsset = *reinterpret_cast<TSoftObjectPtr<UPrimaryDataAsset>*>(ArrayHelper.GetRawPtr(i));
-						FString ChildAssetName = ChildAsset.GetAssetName();
-						if (!ChildAssetName.IsEmpty() && !UniqueAssetNames.Contains(ChildAssetName))
-						{
-							UniqueAssetNames.Add(ChildAssetName);
-							OutNestedAssets.Add(ChildAsset);
-						}
-					}
-				}
-			}
-			// If inner is struct, recurse on each array element
-			else if (const FStructProperty* InnerStructProperty = CastField<FStructProperty>(InnerProp))
-			{
-				for (int32 i = 0; i < ArrayHelper.Num(); ++i)
-				{
-					void* ElementData = ArrayHelper.GetRawPtr(i);
-					if (ElementData)
-					{
-						FindNestedAssetsRecursive(ElementData, InnerStructProperty->Struct, OutNestedAssets, UniqueAssetNames);
-					}
-				}
-			}
-		}
-	}
+	// The plan of the type is built once, subsequent searches only visit properties that can hold a reference
+	FNestedAssetsPlanADAM::Get(Struct)->Scan(Container, OutNestedAssets, UniqueAssetPaths);
+}
+
+void UAsyncDataAssetManagerSubsystem::FindNestedAssetsADAM(const UPrimaryDataAsset* PrimaryDataAsset, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& OutNestedAssets)
+{
+	if (!PrimaryDataAsset)
+		return;
+
+	TSet<FSoftObjectPath> UniqueAssetPaths;
+	FindNestedAssetsRecursive(PrimaryDataAsset, PrimaryDataAsset->GetClass(), OutNestedAssets, UniqueAssetPaths);
 }
 
 TArray<TSoftObjectPtr<UPrimaryDataAsset>> UAsyncDataAssetManagerSubsystem::GetDataByClassADAM(TSubclassOf<UPrimaryDataAsset> DataAssetClass, FName Tag, bool bIgnoreTag)
 {
+	SCOPE_CYCLE_COUNTER(STAT_GetDataByClassADAM);
+
 	TArray<TSoftObjectPtr<UPrimaryDataAsset>> SortedPrimaryDataAsset;
 
 	if (!DataAssetClass)
@@ -191,15 +256,14 @@ TArray<TSoftObjectPtr<UPrimaryDataAsset>> UAsyncDataAssetManagerSubsystem::GetDa
 		return SortedPrimaryDataAsset;
 	}
 
-	for (const FMemoryADAM& Data : DataADAM)
+	// Only the loaded data of the matching classes is visited, the result is cached until it changes
+	const TArray<int32>& ClassSlots = DataADAM.FindClassSlots(DataAssetClass, Tag, bIgnoreTag);
+	SortedPrimaryDataAsset.Reserve(ClassSlots.Num());
+
+	for (int32 Slot : ClassSlots)
 	{
-		if (Data.MemoryReference.IsValid() && Data.SoftReference->GetClass()->IsChildOf(DataAssetClass))
-		{
-			if (bIgnoreTag || Data.Tag == Tag)
-			{
-				SortedPrimaryDataAsset.Add(Data.SoftReference);
-			}
-		}
+		DataADAM.Touch(Slot);
+		SortedPrimaryDataAsset.Add(TSoftObjectPtr<UPrimaryDataAsset>(DataADAM.GetAssetPath(Slot)));
 	}
 
 	return SortedPrimaryDataAsset;
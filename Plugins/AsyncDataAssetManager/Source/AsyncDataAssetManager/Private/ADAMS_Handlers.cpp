@@ -5,30 +5,92 @@
 #include "Engine/AssetManager.h"
 #include "Engine/DataAsset.h"
 #include "AsyncTechnologiesSettings.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "UObject/GarbageCollection.h"
+#include "AssetRegistry/IAssetRegistry.h"
 
-void UAsyncDataAssetManagerSubsystem::RecursiveLoad(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading)
+void UAsyncDataAssetManagerSubsystem::FindNestedAssetsAsync(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId)
 {
-	if (PrimaryDataAsset.IsNull())
+	UPrimaryDataAsset* Asset = PrimaryDataAsset.Get();
+
+	if (!Asset)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ADAM (Recursive Load): No reference is specified in function."));
-		
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Recursive Load): Received a null value."));
+
 		return;
 	}
 
-	if (RecursiveDepthLoading == 0)
-		return;
+	// Pending search keeps the array load from completing before the nested data is queued
+	if (FLoadBatchADAM* LoadBatch = LoadBatchesADAM.Find(BatchId))
+	{
+		LoadBatch->NumPendingSearches++;
+	}
 
-	UPrimaryDataAsset* Asset = PrimaryDataAsset.Get();
+	TWeakObjectPtr<UAsyncDataAssetManagerSubsystem> WeakThis(this);
+	TWeakObjectPtr<UPrimaryDataAsset> WeakAsset(Asset);
+	bool bEnableLog = EnableLog;
 
-	if (!Asset)
+	// The search only reads the properties of the loaded Data Asset, so it is done on a worker thread
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, WeakAsset, PrimaryDataAsset, Tag, NotifyAfterFullLoaded, RecursiveDepthLoading, Priority, BatchId, bEnableLog]()
 	{
-		UE_LOG(LogTemp, Warning, TEXT("ADAM (Recursive Load): Received a null value."));
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> NestedAssets;
+
+		{
+			// Garbage collection can't remove the Data Asset while it is being inspected
+			FGCScopeGuard GCGuard;
+
+			if (UPrimaryDataAsset* LoadedAsset = WeakAsset.Get())
+			{
+				TSet<FSoftObjectPath> UniqueAssetPaths;
+				FindNestedAssetsRecursive(LoadedAsset, LoadedAsset->GetClass(), NestedAssets, UniqueAssetPaths);
+			}
+		}
+
+		if (bEnableLog && NestedAssets.Num() == 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("ADAM (Recursive data): Iteration is complete. All nested data is loaded!"));
+		}
+
+		// Feed the found data back into the loading queue
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, PrimaryDataAsset, NestedAssets = MoveTemp(NestedAssets), Tag, NotifyAfterFullLoaded, RecursiveDepthLoading, Priority, BatchId]()
+		{
+			UAsyncDataAssetManagerSubsystem* This = WeakThis.Get();
+
+			if (!This)
+				return;
+
+			// The nested data of a cancelled array load is not requested
+			if (BatchId != 0 && !This->LoadBatchesADAM.Contains(BatchId))
+				return;
+
+			This->RecursiveLoad(PrimaryDataAsset, NestedAssets, Tag, NotifyAfterFullLoaded, RecursiveDepthLoading, Priority, BatchId);
+
+			// The array load waited for this search
+			if (FLoadBatchADAM* PendingBatch = This->LoadBatchesADAM.Find(BatchId))
+			{
+				PendingBatch->NumPendingSearches--;
+				This->TryCompleteLoadBatchADAM(BatchId);
+			}
+		});
+	});
+}
+
+void UAsyncDataAssetManagerSubsystem::RecursiveLoad(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, const TArray<TSoftObjectPtr<UPrimaryDataAsset>>& NestedAssets, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId)
+{
+	if (PrimaryDataAsset.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Recursive Load): No reference is specified in function."));
 		
 		return;
 	}
 
-	// Checking nested files
-	TArray<TSoftObjectPtr<UPrimaryDataAsset>> NestedAssets = FindNestedAssets(Asset);
+	if (RecursiveDepthLoading == 0)
+		return;
+
+	// The parent was unloaded while its nested data was being searched
+	if (GetIndexDataADAM(PrimaryDataAsset) == -1)
+		return;
 
 	if (NestedAssets.Num() == 0)
 	{
@@ -42,14 +104,16 @@ void UAsyncDataAssetManagerSubsystem::RecursiveLoad(TSoftObjectPtr<UPrimaryDataA
 
 	// Compute depth to pass children. If RecursiveDepthLoading == -1 -> keep -1 (infinite), else decrease by 1
 	int32 ChildDepth = (RecursiveDepthLoading == -1) ? -1 : (RecursiveDepthLoading - 1);
+	// Children inherit the priority of the parent, decreased by the configured decay for each level
+	int32 ChildPriority = Priority - RecursivePriorityDecay;
 
-	for (TSoftObjectPtr<UPrimaryDataAsset>& NestedAsset : NestedAssets)
+	for (const TSoftObjectPtr<UPrimaryDataAsset>& NestedAsset : NestedAssets)
 	{
 		// Calling asynchronous loading
 		if (!NotifyAfterFullLoaded)
 		{
-			// Stop execution if there is a duplicate in memory
-			if (GetIndexDataADAM(NestedAsset) >= 0)
+			// Stop execution if the tag already owns the nested Data Asset. Data owned by other tags or still being loaded is shared.
+			if (IsOwnedByTagADAM(NestedAsset.ToSoftObjectPath(), Tag) && !IsLoadingADAM(NestedAsset))
 			{
 				if (EnableLog)
 				{
@@ -59,15 +123,98 @@ void UAsyncDataAssetManagerSubsystem::RecursiveLoad(TSoftObjectPtr<UPrimaryDataA
 				continue;
 			}
 
-			AddToADAM(NestedAsset, Tag, ChildDepth);
+			AddToADAM(NestedAsset, Tag, ChildDepth, ChildPriority, BatchId);
 		}
 		else
 		{
-			AddAllToADAM(NestedAsset, Tag, ChildDepth);
+			AddAllToADAM(NestedAsset, Tag, ChildDepth, ChildPriority, BatchId);
 		}
 	}
 }
 
+bool UAsyncDataAssetManagerSubsystem::GetNestedClosureADAM(const FSoftObjectPath& AssetPath, int32 RecursiveDepthLoading, TArray<FSoftObjectPath>& OutClosure) const
+{
+	switch (NestedDiscovery)
+	{
+	case ENestedDiscoveryADAM::Manifest:
+		return NestedManifestADAM.GetClosure(AssetPath, RecursiveDepthLoading, OutClosure);
+
+	case ENestedDiscoveryADAM::AssetRegistry:
+		return GetRegistryClosureADAM(AssetPath, RecursiveDepthLoading, OutClosure);
+
+	default:
+		return false;
+	}
+}
+
+bool UAsyncDataAssetManagerSubsystem::GetRegistryClosureADAM(const FSoftObjectPath& AssetPath, int32 RecursiveDepthLoading, TArray<FSoftObjectPath>& OutClosure) const
+{
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// Dependencies are incomplete while the registry is still scanning
+	if (AssetRegistry.IsLoadingAssets())
+		return false;
+
+	int32 NumInitialClosure = OutClosure.Num();
+	FName RootPackageName = AssetPath.GetLongPackageFName();
+
+	TSet<FName> VisitedPackages;
+	VisitedPackages.Add(RootPackageName);
+
+	TArray<FName> CurrentLevel;
+	CurrentLevel.Add(RootPackageName);
+
+	TArray<FName> Dependencies;
+	TArray<FAssetData> PackageAssets;
+	int32 Depth = 1;
+
+	while (!CurrentLevel.IsEmpty() && (RecursiveDepthLoading == -1 || Depth <= RecursiveDepthLoading))
+	{
+		TArray<FName> NextLevel;
+
+		for (FName PackageName : CurrentLevel)
+		{
+			Dependencies.Reset();
+			AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Soft);
+
+			for (FName DependencyName : Dependencies)
+			{
+				bool bIsAlreadyVisited = false;
+				VisitedPackages.Add(DependencyName, &bIsAlreadyVisited);
+
+				if (bIsAlreadyVisited)
+					continue;
+
+				PackageAssets.Reset();
+				AssetRegistry.GetAssetsByPackageName(DependencyName, PackageAssets);
+
+				bool bHasDataAssets = false;
+
+				for (const FAssetData& AssetData : PackageAssets)
+				{
+					if (PrimaryDataAssetClassPaths.Contains(AssetData.AssetClassPath))
+					{
+						OutClosure.Add(AssetData.GetSoftObjectPath());
+						bHasDataAssets = true;
+					}
+				}
+
+				// Only Primary Data Assets lead to further nested data
+				if (bHasDataAssets)
+				{
+					NextLevel.Add(DependencyName);
+				}
+			}
+		}
+
+		CurrentLevel = MoveTemp(NextLevel);
+		Depth++;
+	}
+
+	// Without dependency data the nested data is searched after loading
+	return OutClosure.Num() > NumInitialClosure;
+}
+
 FName UAsyncDataAssetManagerSubsystem::GetTagNameFromStruct(FTagADAM& Tag)
 {
 	if (Tag.GameplayTag.IsValid())
@@ -81,3 +228,48 @@ FName UAsyncDataAssetManagerSubsystem::GetTagNameFromStruct(FTagADAM& Tag)
 
 	return NAME_None;
 }
+
+TArray<FName> UAsyncDataAssetManagerSubsystem::GetTagNamesFromContainerADAM(const FTagContainerADAM& Tag)
+{
+	TArray<FName> TagNameContainerCache;
+
+	// Determines the type of string and returns it to the FName array.
+	if (!Tag.GameplayTags.IsEmpty())
+	{
+		TArray<FGameplayTag> GameplayTagContainer = Tag.GameplayTags.GetGameplayTagArray();
+		// Convert tags to FName.
+		for (FGameplayTag GameplayTag : GameplayTagContainer)
+		{
+			TagNameContainerCache.Add(GameplayTag.GetTagName());
+
+			// Walk the tag hierarchy instead of comparing names
+			if (Tag.bIncludeChildGameplayTags)
+			{
+				FGameplayTagContainer ChildTags = UGameplayTagsManager::Get().RequestGameplayTagChildren(GameplayTag);
+
+				for (const FGameplayTag& ChildTag : ChildTags)
+				{
+					TagNameContainerCache.Add(ChildTag.GetTagName());
+				}
+			}
+		}
+	}
+	
+	if (Tag.TagNameContainer.Num() != 0)
+	{
+		TagNameContainerCache.Append(Tag.TagNameContainer);
+	}
+	
+	if (!Tag.TagName.IsNone())
+	{
+		TagNameContainerCache.Add(Tag.TagName);
+	}
+
+	// Set default value if no other data
+	if (TagNameContainerCache.Num() == 0)
+	{
+		TagNameContainerCache.Add(NAME_None);
+	}
+
+	return TagNameContainerCache;
+}
@@ -0,0 +1,97 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "AsyncDataAssetManagerSubsystem.h"
+
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace LoadTraceADAM
+{
+	// The console commands reach the subsystem of the game instance of the world they are executed in
+	UAsyncDataAssetManagerSubsystem* GetSubsystem(UWorld* World)
+	{
+		UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+
+		return GameInstance ? GameInstance->GetSubsystem<UAsyncDataAssetManagerSubsystem>() : nullptr;
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs StartLoadTraceCommand(
+		TEXT("ADAM.StartLoadTrace"),
+		TEXT("Starts recording the loads and unloads of the ADAM subsystem."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UAsyncDataAssetManagerSubsystem* Subsystem = GetSubsystem(World))
+			{
+				Subsystem->StartLoadTraceADAM();
+			}
+		}));
+
+	static FAutoConsoleCommandWithWorldAndArgs StopLoadTraceCommand(
+		TEXT("ADAM.StopLoadTrace"),
+		TEXT("Stops recording and saves the load trace of the ADAM subsystem. Usage: ADAM.StopLoadTrace [FileName]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UAsyncDataAssetManagerSubsystem* Subsystem = GetSubsystem(World))
+			{
+				Subsystem->StopLoadTraceADAM(Args.IsEmpty() ? FString() : Args[0]);
+			}
+		}));
+}
+
+void UAsyncDataAssetManagerSubsystem::StartLoadTraceADAM()
+{
+	LoadTraceADAM.Start();
+	IsLoadTraceRecording = true;
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Load Trace): Recording is started."));
+	}
+}
+
+bool UAsyncDataAssetManagerSubsystem::StopLoadTraceADAM(const FString& FileName)
+{
+	if (!IsLoadTraceRecording)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Load Trace): Nothing to save. The load trace is not recorded."));
+
+		return false;
+	}
+
+	IsLoadTraceRecording = false;
+
+	FString TraceFile = FileName.IsEmpty() ? GetLoadTraceFileADAM() : FileName;
+	bool bIsSaved = LoadTraceADAM.SaveToFile(TraceFile);
+
+	if (!bIsSaved)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Load Trace): The load trace can't be saved to \"%s\"."), *TraceFile);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Load Trace): %d events are saved to \"%s\"."), LoadTraceADAM.Num(), *TraceFile);
+	}
+
+	LoadTraceADAM.Empty();
+
+	return bIsSaved;
+}
+
+bool UAsyncDataAssetManagerSubsystem::IsLoadTraceRecordingADAM()
+{
+	return IsLoadTraceRecording;
+}
+
+void UAsyncDataAssetManagerSubsystem::RecordTraceADAM(ELoadTraceEventADAM Type, const TArray<FSoftObjectPath>& AssetPaths, const TArray<FName>& Tags, int32 RecursiveDepthLoading, int32 Priority, bool Flag)
+{
+	FLoadTraceEventADAM& Event = LoadTraceADAM.AddEvent(Type, AssetPaths, Tags);
+	Event.RecursiveDepthLoading = RecursiveDepthLoading;
+	Event.Priority = Priority;
+	Event.Flag = Flag;
+}
+
+FString UAsyncDataAssetManagerSubsystem::GetLoadTraceFileADAM()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ADAM/LoadTraceADAM.bin");
+}
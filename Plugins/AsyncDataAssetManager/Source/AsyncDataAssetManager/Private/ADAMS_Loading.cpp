@@ -5,8 +5,9 @@
 #include "Engine/AssetManager.h"
 #include "Engine/DataAsset.h"
 #include "AsyncTechnologiesSettings.h"
+#include "StatsADAM.h"
 
-void UAsyncDataAssetManagerSubsystem::LoadADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FTagADAM Tag, int32 RecursiveDepthLoading, TSoftObjectPtr<UPrimaryDataAsset>& ReturnPrimaryDataAsset)
+void UAsyncDataAssetManagerSubsystem::LoadADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FTagADAM Tag, int32 RecursiveDepthLoading, TSoftObjectPtr<UPrimaryDataAsset>& ReturnPrimaryDataAsset, int32 Priority)
 {
 	if (PrimaryDataAsset.IsNull())
 	{
@@ -15,8 +16,15 @@ void UAsyncDataAssetManagerSubsystem::LoadADAM(TSoftObjectPtr<UPrimaryDataAsset>
 		return;
 	}
 
-	// Stop execution if there is a duplicate in memory
-	if (GetIndexDataADAM(PrimaryDataAsset) >= 0)
+	FName TagName = GetTagNameFromStruct(Tag);
+
+	if (IsLoadTraceRecording)
+	{
+		RecordTraceADAM(ELoadTraceEventADAM::Load, { PrimaryDataAsset.ToSoftObjectPath() }, { TagName }, RecursiveDepthLoading, Priority);
+	}
+
+	// Stop execution if the tag already owns the Data Asset. Data owned by other tags or still being loaded is shared with the new requester.
+	if (IsOwnedByTagADAM(PrimaryDataAsset.ToSoftObjectPath(), TagName) && !IsLoadingADAM(PrimaryDataAsset))
 	{
 		if (EnableLog)
 		{
@@ -31,41 +39,151 @@ void UAsyncDataAssetManagerSubsystem::LoadADAM(TSoftObjectPtr<UPrimaryDataAsset>
 		RecursiveDepthLoading = FMath::Max(RecursiveDepthLoading, -1);
 	}
 
-	// Add in array ADAM and async load. In this case, a load notification occurs after each file is loaded.
-	AddToADAM(PrimaryDataAsset, GetTagNameFromStruct(Tag), RecursiveDepthLoading);
+	TArray<FSoftObjectPath> NestedClosure;
+
+	// The known nested data is requested together with the parent, so the whole closure costs a single round of loading
+	if (RecursiveDepthLoading != 0 && GetNestedClosureADAM(PrimaryDataAsset.ToSoftObjectPath(), RecursiveDepthLoading, NestedClosure))
+	{
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> ClosureBatch;
+		ClosureBatch.Reserve(NestedClosure.Num() + 1);
+		ClosureBatch.Add(PrimaryDataAsset);
+
+		for (const FSoftObjectPath& NestedPath : NestedClosure)
+		{
+			ClosureBatch.Add(TSoftObjectPtr<UPrimaryDataAsset>(NestedPath));
+		}
+
+		// The root reports the requested depth, the nested data of the closure is not searched again
+		AddBatchToADAM(ClosureBatch, TagName, false, RecursiveDepthLoading, Priority, 0, 1);
+	}
+	else
+	{
+		// Add in array ADAM and async load. In this case, a load notification occurs after each file is loaded.
+		AddToADAM(PrimaryDataAsset, TagName, RecursiveDepthLoading, Priority);
+	}
 
 	// Return the value of a soft link
 	ReturnPrimaryDataAsset = PrimaryDataAsset;
+
+	if (PredictivePrefetch)
+	{
+		RecordLoadADAM(TagName, { PrimaryDataAsset.ToSoftObjectPath() });
+	}
 }
 
-void UAsyncDataAssetManagerSubsystem::LoadArrayADAM(TArray<TSoftObjectPtr<UPrimaryDataAsset>> PrimaryDataAssets, FTagADAM Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& ReturnPrimaryDataAssets)
+int32 UAsyncDataAssetManagerSubsystem::LoadArrayADAM(TArray<TSoftObjectPtr<UPrimaryDataAsset>> PrimaryDataAssets, FTagADAM Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& ReturnPrimaryDataAssets, int32 Priority)
 {
+	SCOPE_CYCLE_COUNTER(STAT_LoadArrayADAM);
+
 	if (PrimaryDataAssets.IsEmpty())
 	{
 		UE_LOG(LogTemp, Warning, TEXT("ADAM (Load Array): No reference is specified in function."));
 		
-		return;
+		return 0;
 	}
 
 	// Get and check the type of tag used in a function
 	FName TagName = GetTagNameFromStruct(Tag);
 
-	// Initiate counter for NotifyAfterFullLoaded
-	if (NotifyAfterFullLoaded && !QueueCounterADAM.Contains(TagName))
+	TArray<FSoftObjectPath> AssetPaths;
+
+	if (PredictivePrefetch || IsLoadTraceRecording)
 	{
-		QueueCounterADAM.Add(TagName, 0);
+		AssetPaths.Reserve(PrimaryDataAssets.Num());
+
+		for (const TSoftObjectPtr<UPrimaryDataAsset>& DataAsset : PrimaryDataAssets)
+		{
+			AssetPaths.Add(DataAsset.ToSoftObjectPath());
+		}
 	}
 
+	if (IsLoadTraceRecording)
+	{
+		RecordTraceADAM(ELoadTraceEventADAM::LoadArray, AssetPaths, { TagName }, RecursiveDepthLoading, Priority, NotifyAfterFullLoaded);
+	}
+
+	// Each array load is tracked separately, even if other loads of the tag are in progress
+	int32 BatchId = CreateLoadBatchADAM(TagName, NotifyAfterFullLoaded);
+
+	// Return an array of soft links
+	ReturnPrimaryDataAssets = PrimaryDataAssets;
+
+	RequestArrayADAM(MoveTemp(PrimaryDataAssets), TagName, NotifyAfterFullLoaded, RecursiveDepthLoading, Priority, BatchId, BatchArrayLoading);
+
+	if (PredictivePrefetch)
+	{
+		RecordLoadADAM(TagName, AssetPaths);
+	}
+
+	// An array load with nothing to wait for is not tracked
+	TryCompleteLoadBatchADAM(BatchId);
+
+	return BatchId;
+}
+
+void UAsyncDataAssetManagerSubsystem::RequestArrayADAM(TArray<TSoftObjectPtr<UPrimaryDataAsset>> PrimaryDataAssets, FName TagName, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId, bool SingleRequest)
+{
 	if (RecursiveDepthLoading < -1)
 	{
 		RecursiveDepthLoading = FMath::Max(RecursiveDepthLoading, -1);
 	}
 
+	// Data Assets with a known nested closure are requested together with their nested data in a single batch
+	if (RecursiveDepthLoading != 0 && NestedDiscovery != ENestedDiscoveryADAM::Reflection)
+	{
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> ClosureBatch;
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> ClosureNested;
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> UnknownClosureAssets;
+		TArray<FSoftObjectPath> NestedClosure;
+
+		for (const TSoftObjectPtr<UPrimaryDataAsset>& DataAsset : PrimaryDataAssets)
+		{
+			NestedClosure.Reset();
+
+			if (!GetNestedClosureADAM(DataAsset.ToSoftObjectPath(), RecursiveDepthLoading, NestedClosure))
+			{
+				UnknownClosureAssets.Add(DataAsset);
+
+				continue;
+			}
+
+			ClosureBatch.Add(DataAsset);
+
+			for (const FSoftObjectPath& NestedPath : NestedClosure)
+			{
+				ClosureNested.Add(TSoftObjectPtr<UPrimaryDataAsset>(NestedPath));
+			}
+		}
+
+		if (!ClosureBatch.IsEmpty())
+		{
+			// The roots go first and report the requested depth, the nested data of the closures is not searched again
+			int32 NumClosureRoots = ClosureBatch.Num();
+			ClosureBatch.Append(MoveTemp(ClosureNested));
+
+			AddBatchToADAM(ClosureBatch, TagName, NotifyAfterFullLoaded, RecursiveDepthLoading, Priority, BatchId, NumClosureRoots);
+		}
+
+		// The rest is loaded as usual, its nested data is searched after loading
+		PrimaryDataAssets = MoveTemp(UnknownClosureAssets);
+	}
+
+	// Invoking asynchronous loading of the whole array with a single request.
+	if (SingleRequest)
+	{
+		if (!PrimaryDataAssets.IsEmpty())
+		{
+			AddBatchToADAM(PrimaryDataAssets, TagName, NotifyAfterFullLoaded, RecursiveDepthLoading, Priority, BatchId);
+		}
+
+		return;
+	}
+
 	// Invoking asynchronous loading of each data asset.
 	for (TSoftObjectPtr<UPrimaryDataAsset>& DataAsset : PrimaryDataAssets)
 	{
-		// Stop execution if there is a duplicate in memory
-		if (!NotifyAfterFullLoaded && GetIndexDataADAM(DataAsset) >= 0)
+		// Stop execution if the tag already owns the Data Asset. Data owned by other tags or still being loaded is shared with the new requester.
+		if (!NotifyAfterFullLoaded && IsOwnedByTagADAM(DataAsset.ToSoftObjectPath(), TagName) && !IsLoadingADAM(DataAsset))
 		{
 			if (EnableLog)
 			{
@@ -78,79 +196,296 @@ void UAsyncDataAssetManagerSubsystem::LoadArrayADAM(TArray<TSoftObjectPtr<UPrima
 		// Add in array ADAM and async load
 		if (!NotifyAfterFullLoaded)
 		{
-			AddToADAM(DataAsset, TagName, RecursiveDepthLoading);
+			AddToADAM(DataAsset, TagName, RecursiveDepthLoading, Priority, BatchId);
 		}
 		else
 		{
-			AddAllToADAM(DataAsset, TagName, RecursiveDepthLoading);
+			AddAllToADAM(DataAsset, TagName, RecursiveDepthLoading, Priority, BatchId);
 		}
 	}
+}
+
+void UAsyncDataAssetManagerSubsystem::AddToADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId)
+{
+	FInFlightRequesterADAM Requester;
+	Requester.Tag = Tag;
+	Requester.RecursiveDepthLoading = RecursiveDepthLoading;
+	Requester.Priority = Priority;
+	Requester.BatchId = BatchId;
+
+	if (!AddRequesterADAM(PrimaryDataAsset.ToSoftObjectPath(), Requester))
+		return;
+
+	AddToLoadBatchADAM(BatchId, PrimaryDataAsset.ToSoftObjectPath());
+}
+
+void UAsyncDataAssetManagerSubsystem::AddAllToADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId)
+{
+	FInFlightRequesterADAM Requester;
+	Requester.Tag = Tag;
+	Requester.RecursiveDepthLoading = RecursiveDepthLoading;
+	Requester.Priority = Priority;
+	Requester.NotifyAfterFullLoaded = true;
+	Requester.BatchId = BatchId;
+
+	if (!AddRequesterADAM(PrimaryDataAsset.ToSoftObjectPath(), Requester))
+		return;
+
+	// The array load waits for the data
+	AddToLoadBatchADAM(BatchId, PrimaryDataAsset.ToSoftObjectPath());
+}
+
+bool UAsyncDataAssetManagerSubsystem::AddRequesterADAM(const FSoftObjectPath& AssetPath, const FInFlightRequesterADAM& Requester)
+{
+	int32 TargetIndex = DataADAM.FindSlot(AssetPath);
+
+	// Data assets are added to DataADAM at the moment of the request, so the storage also covers the loading queue
+	if (TargetIndex == INDEX_NONE)
+	{
+		// Recently unloaded data is still in memory
+		if (RestoreFromCoolingADAM(AssetPath, Requester))
+			return true;
+
+		// The descriptor of the entry is assigned after loading
+		DataADAM.Add(AssetPath, nullptr, Requester.Tag, Requester.Priority);
+
+		return RequestInFlightADAM(AssetPath, Requester);
+	}
 
-	// Return an array of soft links
-	ReturnPrimaryDataAssets = PrimaryDataAssets;
+	// The Data Asset is already stored, the tag becomes one more owner and no new request is issued
+	bool bIsNewOwner = DataADAM.AddOwner(TargetIndex, Requester.Tag);
+
+	// A load in progress is shared, the requester receives its own completion notification
+	if (AttachInFlightADAM(AssetPath, Requester))
+		return true;
+
+	// A repeated request of the same owner is ignored, unless the full load notification is expected
+	if (!bIsNewOwner && !Requester.NotifyAfterFullLoaded)
+		return false;
+
+	// The Data Asset is already in memory, only the notification is sent
+	OnStreamableLoaded(TSoftObjectPtr<UPrimaryDataAsset>(AssetPath), Requester.Tag, Requester.RecursiveDepthLoading, Requester.Priority, Requester.NotifyAfterFullLoaded, Requester.RequestId, Requester.BatchId, Requester.IsNestedRequested);
+
+	return true;
 }
 
-void UAsyncDataAssetManagerSubsystem::AddToADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading)
+void UAsyncDataAssetManagerSubsystem::AddBatchToADAM(const TArray<TSoftObjectPtr<UPrimaryDataAsset>>& PrimaryDataAssets, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId, int32 NumClosureRoots)
 {
-	// Add Queue
-	FString DataAssetName = PrimaryDataAsset.GetAssetName();
+	TArray<FSoftObjectPath> BatchPaths;
+	TSet<FSoftObjectPath> UniquePaths;
+
+	BatchPaths.Reserve(PrimaryDataAssets.Num());
+	UniquePaths.Reserve(PrimaryDataAssets.Num());
 
-	if (QueueADAM.Contains(DataAssetName)) 
+	for (int32 i = 0; i < PrimaryDataAssets.Num(); i++)
+	{
+		const TSoftObjectPtr<UPrimaryDataAsset>& DataAsset = PrimaryDataAssets[i];
+		FSoftObjectPath DataAssetPath = DataAsset.ToSoftObjectPath();
+
+		// Duplicates inside the array are requested only once
+		bool bIsAlreadyInBatch = false;
+		UniquePaths.Add(DataAssetPath, &bIsAlreadyInBatch);
+
+		if (DataAssetPath.IsNull() || bIsAlreadyInBatch)
+			continue;
+
+		FInFlightRequesterADAM Requester;
+		Requester.Tag = Tag;
+		Requester.RecursiveDepthLoading = RecursiveDepthLoading;
+		Requester.Priority = Priority;
+		Requester.NotifyAfterFullLoaded = NotifyAfterFullLoaded;
+		Requester.BatchId = BatchId;
+
+		// Data Assets of a known closure are not searched, only its roots report the requested depth
+		if (NumClosureRoots != INDEX_NONE)
+		{
+			Requester.RecursiveDepthLoading = i < NumClosureRoots ? RecursiveDepthLoading : 0;
+			Requester.IsNestedRequested = true;
+		}
+
+		// Stored and cooling Data Assets are shared with the tag and are not part of the batch
+		if (DataADAM.FindSlot(DataAssetPath) != INDEX_NONE || CoolingADAM.Contains(DataAssetPath))
+		{
+			if (AddRequesterADAM(DataAssetPath, Requester))
+			{
+				AddToLoadBatchADAM(BatchId, DataAssetPath);
+			}
+			else if (EnableLog)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ADAM (Load Array): You are trying to load the same Data Asset \"%s\" twice."), *DataAsset.GetAssetName());
+			}
+
+			continue;
+		}
+
+		// The descriptor of the entry is assigned after the batch is loaded
+		DataADAM.Add(DataAssetPath, nullptr, Tag, Priority);
+
+		// Data Assets of the batch share the batch descriptor
+		InFlightADAM.Add(DataAssetPath).Requesters.Add(Requester);
+		IsQueueChanged = true;
+		AddToLoadBatchADAM(BatchId, DataAssetPath);
+
+		BatchPaths.Add(DataAssetPath);
+	}
+
+	if (BatchPaths.IsEmpty())
 		return;
 
-	QueueADAM.Add(DataAssetName);
+	int32 BatchKey = ++BatchCounterADAM;
+	BatchHandlesADAM.Add(BatchKey, nullptr);
+
+	// Progress and cancellation of the Data Assets of the batch go through the batch descriptor
+	for (const FSoftObjectPath& DataAssetPath : BatchPaths)
+	{
+		InFlightADAM[DataAssetPath].BatchKey = BatchKey;
+	}
 
 	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
 	// Create a delegate
 	FStreamableDelegate Delegate = FStreamableDelegate::CreateUObject(
 	this,
-	&UAsyncDataAssetManagerSubsystem::OnLoaded,
-	PrimaryDataAsset,
-	Tag,
-	RecursiveDepthLoading);
+	&UAsyncDataAssetManagerSubsystem::OnBatchLoaded,
+	BatchKey,
+	BatchPaths);
 
-	// Determine whether the descriptor will be declared and stored
-	TSharedPtr<FStreamableHandle> DataAssetHandle = StreamableManager.RequestAsyncLoad(PrimaryDataAsset.ToSoftObjectPath(),	Delegate);
-	
-	// Adding new data
-	if (DataAssetHandle)
+	// A single request for the whole array
+	// Prefetched Data Assets are held by the batch after the request
+	TArray<FSoftObjectPath> PrefetchedPaths;
+
+	if (!PrefetchesADAM.IsEmpty())
+	{
+		PrefetchedPaths = BatchPaths.FilterByPredicate([this](const FSoftObjectPath& DataAssetPath) { return PrefetchesADAM.Contains(DataAssetPath); });
+	}
+
+	TSharedPtr<FStreamableHandle> BatchHandle = StreamableManager.RequestAsyncLoad(MoveTemp(BatchPaths), Delegate, Priority);
+
+	for (const FSoftObjectPath& PrefetchedPath : PrefetchedPaths)
 	{
-		AddDataToArrayADAM(PrimaryDataAsset, DataAssetHandle, Tag);
+		ConsumePrefetchADAM(PrefetchedPath);
+	}
+
+	if (TSharedPtr<FStreamableHandle>* PendingBatchHandle = BatchHandlesADAM.Find(BatchKey))
+	{
+		*PendingBatchHandle = BatchHandle;
+	}
+	else if (BatchHandle.IsValid())
+	{
+		// The batch was already in memory and the notification has been received
+		BatchHandle->ReleaseHandle();
 	}
 }
 
-void UAsyncDataAssetManagerSubsystem::AddAllToADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading)
+bool UAsyncDataAssetManagerSubsystem::RequestInFlightADAM(const FSoftObjectPath& AssetPath, const FInFlightRequesterADAM& Requester)
 {
+	InFlightADAM.Add(AssetPath).Requesters.Add(Requester);
+	IsQueueChanged = true;
+
 	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
 	// Create a delegate
 	FStreamableDelegate Delegate = FStreamableDelegate::CreateUObject(
 	this,
-	&UAsyncDataAssetManagerSubsystem::OnAllLoaded,
-	PrimaryDataAsset,
-	Tag,
-	RecursiveDepthLoading);
+	&UAsyncDataAssetManagerSubsystem::OnInFlightLoaded,
+	AssetPath);
 
-	// Determine whether the descriptor will be declared and stored
-	TSharedPtr<FStreamableHandle> DataAssetHandle = StreamableManager.RequestAsyncLoad(PrimaryDataAsset.ToSoftObjectPath(),	Delegate);
-	
-	// Adding new data
-	if (DataAssetHandle)
+	TSharedPtr<FStreamableHandle> DataAssetHandle;
+
+	// A Primary Asset is loaded together with its bundles through the Asset Manager, the descriptor covers both
+	if (FPrimaryBundlesADAM* PrimaryBundles = PrimaryBundlesADAM.Find(AssetPath))
 	{
-		AddDataToArrayADAM(PrimaryDataAsset, DataAssetHandle, Tag);
+		PrimaryBundles->IsRequested = true;
+		DataAssetHandle = UAssetManager::Get().LoadPrimaryAsset(PrimaryBundles->PrimaryAssetId, PrimaryBundles->Bundles, Delegate, Requester.Priority);
 	}
 
-	// Increment the counter of data
-	if (QueueCounterADAM.Contains(Tag)) QueueCounterADAM[Tag]++;
+	// The Asset Manager returns no descriptor if the Primary Asset is already loaded with the bundles
+	if (!DataAssetHandle.IsValid())
+	{
+		DataAssetHandle = StreamableManager.RequestAsyncLoad(AssetPath, Delegate, Requester.Priority);
+	}
+
+	if (!DataAssetHandle.IsValid())
+	{
+		// Nothing to load, the entry is not kept
+		InFlightADAM.Remove(AssetPath);
+		DataADAM.RemoveAt(DataADAM.FindSlot(AssetPath));
+		ReleasePrimaryBundlesADAM(AssetPath);
+
+		return false;
+	}
+
+	// The prefetched Data Asset is held by the request now
+	ConsumePrefetchADAM(AssetPath);
+
+	if (FInFlightADAM* InFlight = InFlightADAM.Find(AssetPath))
+	{
+		InFlight->StreamableHandle = DataAssetHandle;
+	}
+	else
+	{
+		// The Data Asset was already in memory and the notification has been received, the entries hold their own descriptors
+		DataAssetHandle->ReleaseHandle();
+	}
+
+	return true;
 }
 
-void UAsyncDataAssetManagerSubsystem::AddDataToArrayADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, TSharedPtr<FStreamableHandle> DataAssetHandle, FName Tag)
+bool UAsyncDataAssetManagerSubsystem::RestoreFromCoolingADAM(const FSoftObjectPath& AssetPath, const FInFlightRequesterADAM& Requester)
 {
-	FMemoryADAM NewDataAsset;
-	NewDataAsset.SoftReference = PrimaryDataAsset;
-	NewDataAsset.MemoryReference = DataAssetHandle;
-	NewDataAsset.Tag = Tag;
+	FCoolingADAM Cooling;
+
+	if (!CoolingADAM.RemoveAndCopyValue(AssetPath, Cooling))
+		return false;
+
+	if (Cooling.ResidentSize != INDEX_NONE)
+	{
+		CoolingResidentSize -= Cooling.ResidentSize;
+	}
+
+	// The kept descriptor can't be reused if the data has been freed in the meantime
+	if (!GetStreamableAssetADAM(Cooling.StreamableHandle, AssetPath))
+	{
+		ReleaseStreamableHandleADAM(Cooling.StreamableHandle);
+
+		return false;
+	}
+
+	FHandleADAM NewHandle = DataADAM.Add(AssetPath, MoveTemp(Cooling.StreamableHandle), Requester.Tag, FMath::Max(Cooling.Priority, Requester.Priority));
+	DataADAM.SetResidentSize(NewHandle.Index, Cooling.ResidentSize);
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Load): Data Asset \"%s\" is restored from the cooling pool."), *AssetPath.GetAssetName());
+	}
 
-	DataADAM.Add(NewDataAsset);
+	// No new request is issued, only the notification is sent
+	OnStreamableLoaded(TSoftObjectPtr<UPrimaryDataAsset>(AssetPath), Requester.Tag, Requester.RecursiveDepthLoading, Requester.Priority, Requester.NotifyAfterFullLoaded, Requester.RequestId, Requester.BatchId, Requester.IsNestedRequested);
+
+	return true;
+}
+
+bool UAsyncDataAssetManagerSubsystem::AttachInFlightADAM(const FSoftObjectPath& AssetPath, const FInFlightRequesterADAM& Requester)
+{
+	FInFlightADAM* InFlight = InFlightADAM.Find(AssetPath);
+
+	if (!InFlight)
+		return false;
+
+	InFlight->Requesters.Add(Requester);
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Load): Data Asset \"%s\" is already being loaded, the request is attached to it."), *AssetPath.GetAssetName());
+	}
+
+	// A more urgent requester raises the priority of the load in progress
+	int32 TargetIndex = DataADAM.FindSlot(AssetPath);
+
+	if (TargetIndex != INDEX_NONE)
+	{
+		ReprioritizeSlotADAM(TargetIndex, Requester.Priority);
+	}
+
+	return true;
 }
 
 void UAsyncDataAssetManagerSubsystem::FastLoadADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, TSoftObjectPtr<UPrimaryDataAsset>& ReturnPrimaryDataAsset)
@@ -162,6 +497,11 @@ void UAsyncDataAssetManagerSubsystem::FastLoadADAM(TSoftObjectPtr<UPrimaryDataAs
 		return;
 	}
 
+	if (IsLoadTraceRecording)
+	{
+		RecordTraceADAM(ELoadTraceEventADAM::FastLoad, { PrimaryDataAsset.ToSoftObjectPath() }, TArray<FName>());
+	}
+
 	// Stop execution if there is a duplicate in memory
 	if (GetIndexDataADAM(PrimaryDataAsset) >= 0)
 	{
@@ -179,9 +519,12 @@ void UAsyncDataAssetManagerSubsystem::FastLoadADAM(TSoftObjectPtr<UPrimaryDataAs
 	FName Tag;
 	FStreamableDelegate Delegate = FStreamableDelegate::CreateUObject(
 			this,
-			&UAsyncDataAssetManagerSubsystem::OnLoaded,
+			&UAsyncDataAssetManagerSubsystem::OnStreamableLoaded,
 			PrimaryDataAsset,
 			Tag,
+			0,
+			FStreamableManager::DefaultAsyncLoadPriority,
+			false,
 			0);
 
 	// This handle is not stored in memory
@@ -190,3 +533,166 @@ void UAsyncDataAssetManagerSubsystem::FastLoadADAM(TSoftObjectPtr<UPrimaryDataAs
 	// Return soft reference of Data Asset
 	ReturnPrimaryDataAsset = PrimaryDataAsset;
 }
+
+void UAsyncDataAssetManagerSubsystem::ReprioritizeADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, int32 Priority)
+{
+	if (PrimaryDataAsset.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Reprioritize): No reference is specified in function."));
+
+		return;
+	}
+
+	int32 TargetIndex = GetIndexDataADAM(PrimaryDataAsset);
+
+	if (TargetIndex == -1)
+		return;
+
+	ReprioritizeSlotADAM(TargetIndex, Priority);
+}
+
+void UAsyncDataAssetManagerSubsystem::ReprioritizeTagADAM(FTagADAM Tag, int32 Priority)
+{
+	const TSet<int32>* TagBucket = DataADAM.FindTagBucket(GetTagNameFromStruct(Tag));
+
+	if (!TagBucket)
+		return;
+
+	for (int32 TargetIndex : *TagBucket)
+	{
+		ReprioritizeSlotADAM(TargetIndex, Priority);
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::ReprioritizeSlotADAM(int32 DataAssetIndex, int32 Priority)
+{
+	if (!DataADAM.IsValidIndex(DataAssetIndex) || Priority <= DataADAM.GetPriority(DataAssetIndex))
+		return;
+
+	DataADAM.SetPriority(DataAssetIndex, Priority);
+
+	// Loaded data does not need a new priority
+	const FSoftObjectPath& DataAssetPath = DataADAM.GetAssetPath(DataAssetIndex);
+
+	const FInFlightADAM* InFlight = InFlightADAM.Find(DataAssetPath);
+
+	if (!InFlight)
+		return;
+
+	// The StreamableManager can't change the priority of a request in progress, so only the package requests behind it are raised.
+	// A request issued through the Asset Manager also covers the bundles of the Primary Asset. A member of a batch raises its own package only.
+	TArray<FSoftObjectPath> RequestedPaths;
+
+	if (InFlight->StreamableHandle.IsValid())
+	{
+		InFlight->StreamableHandle->GetRequestedAssets(RequestedPaths);
+	}
+	else
+	{
+		RequestedPaths.Add(DataAssetPath);
+	}
+
+	TSet<FName> PackageNames;
+
+	for (const FSoftObjectPath& RequestedPath : RequestedPaths)
+	{
+		FName PackageName = RequestedPath.GetLongPackageFName();
+
+		// Only a package that is already being loaded is requested again: the package loader merges the repeated request
+		// into the one in progress and raises its priority. Otherwise the request would start a load outside the StreamableManager.
+		if (PackageNames.Contains(PackageName) || GetAsyncLoadPercentage(PackageName) < 0.0f)
+			continue;
+
+		PackageNames.Add(PackageName);
+		LoadPackageAsync(PackageName.ToString(), FLoadPackageAsyncDelegate(), Priority);
+	}
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Reprioritize): Data Asset \"%s\" priority raised to %d for %d package(s) in progress."), *DataAssetPath.GetAssetName(), Priority, PackageNames.Num());
+	}
+}
+
+int32 UAsyncDataAssetManagerSubsystem::CreateLoadBatchADAM(FName Tag, bool NotifyAfterFullLoaded)
+{
+	int32 BatchId = ++LoadBatchCounterADAM;
+
+	FLoadBatchADAM& LoadBatch = LoadBatchesADAM.Add(BatchId);
+	LoadBatch.Tag = Tag;
+	LoadBatch.NotifyAfterFullLoaded = NotifyAfterFullLoaded;
+
+	return BatchId;
+}
+
+void UAsyncDataAssetManagerSubsystem::AddToLoadBatchADAM(int32 BatchId, const FSoftObjectPath& AssetPath)
+{
+	// Data Assets requested several times within the array load are waited for once
+	if (FLoadBatchADAM* LoadBatch = LoadBatchesADAM.Find(BatchId))
+	{
+		LoadBatch->PendingPaths.Add(AssetPath);
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::ResolveLoadBatchADAM(int32 BatchId, const FSoftObjectPath& AssetPath)
+{
+	FLoadBatchADAM* LoadBatch = LoadBatchesADAM.Find(BatchId);
+
+	if (!LoadBatch || LoadBatch->PendingPaths.Remove(AssetPath) == 0)
+		return;
+
+	LoadBatch->NumCompleted++;
+
+	TryCompleteLoadBatchADAM(BatchId);
+}
+
+void UAsyncDataAssetManagerSubsystem::PreloadADAM(const TArray<FPreloadADAM>& PreloadEntries, int32 Priority)
+{
+	TArray<int32> BatchIds;
+
+	// All entries are requested before any of them can complete
+	for (const FPreloadADAM& PreloadEntry : PreloadEntries)
+	{
+		if (PreloadEntry.DataAssets.IsEmpty())
+			continue;
+
+		int32 BatchId = CreateLoadBatchADAM(PreloadEntry.Tag, false);
+		PreloadBatchIdsADAM.Add(BatchId);
+		BatchIds.Add(BatchId);
+
+		RequestArrayADAM(PreloadEntry.DataAssets, PreloadEntry.Tag, false, PreloadEntry.RecursiveDepthLoading, Priority, BatchId, true);
+	}
+
+	if (BatchIds.IsEmpty())
+	{
+		IsPreloaded = true;
+
+		return;
+	}
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Preload): %d preload entries are requested."), BatchIds.Num());
+	}
+
+	// Entries that are already in memory are completed right away
+	for (int32 BatchId : BatchIds)
+	{
+		TryCompleteLoadBatchADAM(BatchId);
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::CompletePreloadBatchADAM(int32 BatchId)
+{
+	if (PreloadBatchIdsADAM.Remove(BatchId) == 0 || !PreloadBatchIdsADAM.IsEmpty())
+		return;
+
+	IsPreloaded = true;
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Preload): Startup preload is complete."));
+	}
+
+	// Inform the FOnPreloadedADAM subsystem delegate that the critical data is stored
+	OnPreloadedADAM.Broadcast();
+}
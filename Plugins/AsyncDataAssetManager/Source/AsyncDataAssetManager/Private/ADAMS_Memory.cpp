@@ -0,0 +1,199 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "AsyncDataAssetManagerSubsystem.h"
+
+#include "Engine/DataAsset.h"
+#include "AsyncTechnologiesSettings.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "StatsADAM.h"
+
+// Broadcasts the memory trim notification of the engine, so the response can be checked on platforms that never report memory pressure
+static FAutoConsoleCommand SimulateMemoryPressureCommandADAM(
+	TEXT("ADAM.SimulateMemoryPressure"),
+	TEXT("Simulates the memory pressure notification of the engine. The ADAM subsystem evicts the least recently used data of the evictable tiers."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FCoreDelegates::GetMemoryTrimDelegate().Broadcast();
+	}));
+
+int64 UAsyncDataAssetManagerSubsystem::GetResidentSizeADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset)
+{
+	int32 TargetIndex = GetIndexDataADAM(PrimaryDataAsset);
+
+	return TargetIndex != INDEX_NONE ? DataADAM.GetResidentSize(TargetIndex) : INDEX_NONE;
+}
+
+int64 UAsyncDataAssetManagerSubsystem::GetTotalResidentSizeADAM()
+{
+	return DataADAM.GetTotalResidentSize() + CoolingResidentSize;
+}
+
+void UAsyncDataAssetManagerSubsystem::SetEvictionTierADAM(FTagADAM Tag, EEvictionTierADAM EvictionTier)
+{
+	EvictionTiers.Add(GetTagNameFromStruct(Tag), EvictionTier);
+}
+
+void UAsyncDataAssetManagerSubsystem::SimulateMemoryPressureADAM()
+{
+	OnMemoryPressureADAM();
+}
+
+void UAsyncDataAssetManagerSubsystem::UpdateResidencyADAM(int32 DataAssetIndex)
+{
+	if (!DataADAM.IsValidIndex(DataAssetIndex))
+		return;
+
+	DataADAM.Touch(DataAssetIndex);
+
+	const TSharedPtr<FStreamableHandle>& DataAssetHandle = DataADAM.GetStreamableHandle(DataAssetIndex);
+	UObject* DataAsset = GetStreamableAssetADAM(DataAssetHandle, DataADAM.GetAssetPath(DataAssetIndex));
+
+	if (!DataAsset)
+		return;
+
+	// Finished loads are resolved once and bucketed by class for GetDataByClassADAM
+	DataADAM.SetLoadedAsset(DataAssetIndex, DataAsset);
+
+	// The size is measured once, shared data is not measured again for each owner
+	if (DataADAM.GetResidentSize(DataAssetIndex) != INDEX_NONE)
+		return;
+
+	// Serialized size of the Data Asset and its subobjects together with their resources
+	DataADAM.SetResidentSize(DataAssetIndex, DataAsset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal));
+}
+
+EEvictionTierADAM UAsyncDataAssetManagerSubsystem::GetEvictionTierADAM(int32 DataAssetIndex) const
+{
+	const TArray<FName>& Owners = DataADAM.GetOwners(DataAssetIndex);
+
+	// Data without owners is no longer needed by anyone
+	if (Owners.IsEmpty())
+		return EEvictionTierADAM::Low;
+
+	EEvictionTierADAM EvictionTier = EEvictionTierADAM::Low;
+
+	for (FName Owner : Owners)
+	{
+		const EEvictionTierADAM* OwnerTier = EvictionTiers.Find(Owner);
+		EvictionTier = FMath::Max(EvictionTier, OwnerTier ? *OwnerTier : DefaultEvictionTier);
+	}
+
+	return EvictionTier;
+}
+
+int32 UAsyncDataAssetManagerSubsystem::EvictADAM(int64 TargetResidentSize)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EvictADAM);
+
+	// Unloaded data of the cooling pool is released before the stored data
+	EvictCoolingADAM(TargetResidentSize);
+
+	if (GetTotalResidentSizeADAM() <= TargetResidentSize)
+		return 0;
+
+	struct FEvictionCandidate
+	{
+		FHandleADAM Handle;
+		EEvictionTierADAM EvictionTier;
+		double LastAccessTime;
+	};
+
+	TArray<FEvictionCandidate> Candidates;
+
+	for (TConstSetBitIterator<> It = DataADAM.CreateConstIterator(); It; ++It)
+	{
+		int32 Slot = It.GetIndex();
+
+		// Unmeasured data is still being loaded or post-processed
+		if (DataADAM.GetResidentSize(Slot) == INDEX_NONE || InFlightADAM.Contains(DataADAM.GetAssetPath(Slot)))
+			continue;
+
+		EEvictionTierADAM EvictionTier = GetEvictionTierADAM(Slot);
+
+		if (EvictionTier == EEvictionTierADAM::Never)
+			continue;
+
+		Candidates.Add({ DataADAM.GetHandle(Slot), EvictionTier, DataADAM.GetLastAccessTime(Slot) });
+	}
+
+	// Lower tiers first, the least recently used data first within a tier
+	Candidates.Sort([](const FEvictionCandidate& A, const FEvictionCandidate& B)
+	{
+		return A.EvictionTier != B.EvictionTier ? A.EvictionTier < B.EvictionTier : A.LastAccessTime < B.LastAccessTime;
+	});
+
+	TArray<TPair<TSoftObjectPtr<UPrimaryDataAsset>, TArray<FName>>> EvictedDataAssets;
+
+	for (const FEvictionCandidate& Candidate : Candidates)
+	{
+		if (GetTotalResidentSizeADAM() <= TargetResidentSize)
+			break;
+
+		if (!DataADAM.IsValidHandle(Candidate.Handle))
+			continue;
+
+		int32 Slot = Candidate.Handle.Index;
+		EvictedDataAssets.Emplace(TSoftObjectPtr<UPrimaryDataAsset>(DataADAM.GetAssetPath(Slot)), DataADAM.GetOwners(Slot));
+
+		if (EnableLog)
+		{
+			UE_LOG(LogTemp, Display, TEXT("ADAM (Evict): Unload data asset \"%s\" (%lld bytes, index: %d)"), *DataADAM.GetAssetPath(Slot).GetAssetName(), DataADAM.GetResidentSize(Slot), Slot);
+		}
+
+		RemoveFromADAM(Slot, false);
+	}
+
+	// Notifications are sent after the eviction, so listeners can't change the storage while it is in progress
+	for (const TPair<TSoftObjectPtr<UPrimaryDataAsset>, TArray<FName>>& EvictedDataAsset : EvictedDataAssets)
+	{
+		OnEvictedADAM.Broadcast(EvictedDataAsset.Key, EvictedDataAsset.Value);
+	}
+
+	if (EnableLog && GetTotalResidentSizeADAM() > TargetResidentSize)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Evict): Resident size %lld bytes exceeds the target of %lld bytes, the rest of the data can't be evicted."), GetTotalResidentSizeADAM(), TargetResidentSize);
+	}
+
+	return EvictedDataAssets.Num();
+}
+
+void UAsyncDataAssetManagerSubsystem::EnforceMemoryBudgetADAM()
+{
+	if (MemoryBudget > 0)
+	{
+		EvictADAM(MemoryBudget);
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::OnMemoryPressureADAM()
+{
+	// The storage is only changed on the game thread
+	if (!IsInGameThread())
+	{
+		TWeakObjectPtr<UAsyncDataAssetManagerSubsystem> WeakThis(this);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis]()
+		{
+			if (UAsyncDataAssetManagerSubsystem* This = WeakThis.Get())
+			{
+				This->OnMemoryPressureADAM();
+			}
+		});
+
+		return;
+	}
+
+	// Unloaded and speculative data is not worth keeping under memory pressure
+	ClearCoolingADAM();
+	ClearPrefetchADAM();
+
+	int64 ReferenceSize = MemoryBudget > 0 ? MemoryBudget : GetTotalResidentSizeADAM();
+	int32 NumEvicted = EvictADAM(ReferenceSize * MemoryPressureTarget / 100);
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Memory Pressure): %d Data Assets are evicted, resident size is %lld bytes."), NumEvicted, GetTotalResidentSizeADAM());
+	}
+}
@@ -0,0 +1,151 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "AsyncDataAssetManagerSubsystem.h"
+
+#include "Engine/DataAsset.h"
+#include "AsyncTechnologiesSettings.h"
+#include "StatsADAM.h"
+
+int32 UAsyncDataAssetManagerSubsystem::RequestNativeADAM(const TArray<FSoftObjectPath>& AssetPaths, FName Tag, int32 RecursiveDepthLoading, int32 Priority, TFunction<void(UPrimaryDataAsset*)>&& OnLoaded, TFunction<void()>&& OnCompleted)
+{
+	int32 RequestId = ++NativeRequestCounterADAM;
+
+	FNativeRequestADAM& NativeRequest = NativeRequestsADAM.Add(RequestId);
+	NativeRequest.OnLoaded = MoveTemp(OnLoaded);
+	NativeRequest.OnCompleted = MoveTemp(OnCompleted);
+
+	RecursiveDepthLoading = FMath::Max(RecursiveDepthLoading, -1);
+
+	TSet<FSoftObjectPath> UniquePaths;
+	TArray<FSoftObjectPath> NestedClosure;
+	TArray<TSoftObjectPtr<UPrimaryDataAsset>> NestedBatch;
+
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		// Duplicates inside the array are reported only once
+		bool bIsAlreadyRequested = false;
+		UniquePaths.Add(AssetPath, &bIsAlreadyRequested);
+
+		if (AssetPath.IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ADAM (Native Load): No reference is specified in function."));
+
+			continue;
+		}
+
+		if (bIsAlreadyRequested)
+			continue;
+
+		FInFlightRequesterADAM Requester;
+		Requester.Tag = Tag;
+		Requester.RecursiveDepthLoading = RecursiveDepthLoading;
+		Requester.Priority = Priority;
+		Requester.RequestId = RequestId;
+
+		// The known nested data is requested right away instead of being searched after loading
+		NestedClosure.Reset();
+
+		if (RecursiveDepthLoading != 0 && GetNestedClosureADAM(AssetPath, RecursiveDepthLoading, NestedClosure))
+		{
+			Requester.IsNestedRequested = true;
+
+			for (const FSoftObjectPath& NestedPath : NestedClosure)
+			{
+				NestedBatch.Add(TSoftObjectPtr<UPrimaryDataAsset>(NestedPath));
+			}
+		}
+
+		NativeRequestsADAM[RequestId].NumPending++;
+
+		// A Data Asset the tag already owns is reported without a new request
+		if (!AddRequesterADAM(AssetPath, Requester))
+		{
+			OnStreamableLoaded(TSoftObjectPtr<UPrimaryDataAsset>(AssetPath), Tag, 0, Priority, false, RequestId);
+		}
+	}
+
+	if (!NestedBatch.IsEmpty())
+	{
+		AddBatchToADAM(NestedBatch, Tag, false, 0, Priority);
+	}
+
+	// Nothing to wait for
+	if (NativeRequestsADAM[RequestId].NumPending == 0)
+	{
+		NativeRequestsADAM[RequestId].NumPending = 1;
+		ReleaseNativeRequesterADAM(RequestId);
+	}
+
+	return RequestId;
+}
+
+void UAsyncDataAssetManagerSubsystem::OnNativeLoaded(const FPostLoadADAM& PostLoad)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OnLoadedADAM);
+
+	UPrimaryDataAsset* LoadedObject = PostLoad.SoftReference.Get();
+
+	if (LoadedObject)
+	{
+		UpdateResidencyADAM(GetIndexDataADAM(PostLoad.SoftReference));
+
+		// Nested data is searched once, on a worker thread
+		if (PostLoad.RecursiveDepthLoading != 0 && !PostLoad.IsNestedRequested)
+		{
+			FindNestedAssetsAsync(PostLoad.SoftReference, PostLoad.Tag, false, PostLoad.RecursiveDepthLoading, PostLoad.Priority);
+		}
+
+		if (EnableLog)
+		{
+			UE_LOG(LogTemp, Display, TEXT("ADAM (Native Load): Data Asset \"%s\" is loaded."), *PostLoad.SoftReference.GetAssetName());
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ADAM (Native Load): Data Asset \"%s\" can't be loaded."), *PostLoad.SoftReference.GetAssetName());
+	}
+
+	// The request was cancelled, the data stays stored for the tag
+	FNativeRequestADAM* NativeRequest = NativeRequestsADAM.Find(PostLoad.RequestId);
+
+	if (!NativeRequest)
+		return;
+
+	// The callback can issue or cancel requests, so it is moved out of the table for the call
+	if (NativeRequest->OnLoaded)
+	{
+		TFunction<void(UPrimaryDataAsset*)> OnLoaded = MoveTemp(NativeRequest->OnLoaded);
+		OnLoaded(LoadedObject);
+
+		if (FNativeRequestADAM* PendingRequest = NativeRequestsADAM.Find(PostLoad.RequestId))
+		{
+			PendingRequest->OnLoaded = MoveTemp(OnLoaded);
+		}
+	}
+
+	ReleaseNativeRequesterADAM(PostLoad.RequestId);
+}
+
+void UAsyncDataAssetManagerSubsystem::ReleaseNativeRequesterADAM(int32 RequestId)
+{
+	FNativeRequestADAM* NativeRequest = NativeRequestsADAM.Find(RequestId);
+
+	if (!NativeRequest || --NativeRequest->NumPending > 0)
+		return;
+
+	TFunction<void()> OnCompleted = MoveTemp(NativeRequest->OnCompleted);
+	NativeRequestsADAM.Remove(RequestId);
+
+	if (!OnCompleted)
+		return;
+
+	// Callers are not called in the middle of an unload
+	if (UnloadDepthADAM > 0)
+	{
+		DeferredNotificationsADAM.Add(MoveTemp(OnCompleted));
+
+		return;
+	}
+
+	OnCompleted();
+}
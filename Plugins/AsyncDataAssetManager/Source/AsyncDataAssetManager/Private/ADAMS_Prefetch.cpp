@@ -0,0 +1,162 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "AsyncDataAssetManagerSubsystem.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/DataAsset.h"
+#include "AsyncTechnologiesSettings.h"
+#include "Misc/Paths.h"
+
+FPrefetchStatsADAM UAsyncDataAssetManagerSubsystem::GetPrefetchStatsADAM()
+{
+	FPrefetchStatsADAM Stats = PrefetchStats;
+	Stats.Accuracy = Stats.NumPrefetched > 0 ? float(Stats.NumHits) / Stats.NumPrefetched : 0.0f;
+
+	return Stats;
+}
+
+void UAsyncDataAssetManagerSubsystem::ClearPrefetchADAM()
+{
+	TArray<FSoftObjectPath> PrefetchPaths;
+	PrefetchesADAM.GetKeys(PrefetchPaths);
+
+	for (const FSoftObjectPath& PrefetchPath : PrefetchPaths)
+	{
+		ReleasePrefetchADAM(PrefetchPath);
+	}
+
+	PredictedTag = NAME_None;
+}
+
+void UAsyncDataAssetManagerSubsystem::RecordLoadADAM(FName Tag, const TArray<FSoftObjectPath>& AssetPaths)
+{
+	if (!PredictivePrefetch)
+		return;
+
+	// Loads within the same tag only update its data, the prediction is made once per transition
+	if (!PrefetchModelADAM.RecordLoad(Tag, AssetPaths, PrefetchAssetsPerTag))
+		return;
+
+	// The prediction was wrong, the prefetched data is not needed
+	if (!PredictedTag.IsNone() && PredictedTag != Tag)
+	{
+		ClearPrefetchADAM();
+	}
+
+	PredictedTag = PrefetchModelADAM.PredictNext(Tag, PrefetchThreshold);
+
+	if (PredictedTag.IsNone())
+		return;
+
+	const TArray<FSoftObjectPath>* PredictedAssets = PrefetchModelADAM.FindAssets(PredictedTag);
+
+	if (!PredictedAssets)
+		return;
+
+	PrefetchStats.NumPredictions++;
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	double ExpireTime = FPlatformTime::Seconds() + PrefetchLifetime;
+	int32 NumPrefetched = 0;
+
+	for (const FSoftObjectPath& AssetPath : *PredictedAssets)
+	{
+		// Stored data doesn't need a prefetch
+		if (DataADAM.FindSlot(AssetPath) != INDEX_NONE || CoolingADAM.Contains(AssetPath) || PrefetchesADAM.Contains(AssetPath))
+			continue;
+
+		TSharedPtr<FStreamableHandle> PrefetchHandle = StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate(), PrefetchPriority);
+
+		if (!PrefetchHandle.IsValid())
+			continue;
+
+		FPrefetchADAM& Prefetch = PrefetchesADAM.Add(AssetPath);
+		Prefetch.StreamableHandle = PrefetchHandle;
+		Prefetch.ExpireTime = ExpireTime;
+
+		NumPrefetched++;
+	}
+
+	PrefetchStats.NumPrefetched += NumPrefetched;
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Prefetch): Tag \"%s\" is predicted after \"%s\", %d Data Assets are prefetched."), *PredictedTag.ToString(), *Tag.ToString(), NumPrefetched);
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::ConsumePrefetchADAM(const FSoftObjectPath& AssetPath)
+{
+	FPrefetchADAM Prefetch;
+
+	if (!PrefetchesADAM.RemoveAndCopyValue(AssetPath, Prefetch))
+		return;
+
+	PrefetchStats.NumHits++;
+
+	// The request keeps the Data Asset now
+	if (Prefetch.StreamableHandle.IsValid())
+	{
+		Prefetch.StreamableHandle->ReleaseHandle();
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::ReleasePrefetchADAM(const FSoftObjectPath& AssetPath)
+{
+	FPrefetchADAM Prefetch;
+
+	if (!PrefetchesADAM.RemoveAndCopyValue(AssetPath, Prefetch))
+		return;
+
+	PrefetchStats.NumWasted++;
+
+	if (!Prefetch.StreamableHandle.IsValid())
+		return;
+
+	// Only loaded data took memory, a load in progress is cancelled
+	if (Prefetch.StreamableHandle->HasLoadCompleted())
+	{
+		if (UObject* DataAsset = Prefetch.StreamableHandle->GetLoadedAsset())
+		{
+			PrefetchStats.WastedBytes += DataAsset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+
+		Prefetch.StreamableHandle->ReleaseHandle();
+	}
+	else
+	{
+		Prefetch.StreamableHandle->CancelHandle();
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::TickPrefetchADAM()
+{
+	if (PrefetchesADAM.IsEmpty())
+		return;
+
+	double CurrentTime = FPlatformTime::Seconds();
+	TArray<FSoftObjectPath> ExpiredPaths;
+
+	for (const TPair<FSoftObjectPath, FPrefetchADAM>& Prefetch : PrefetchesADAM)
+	{
+		if (Prefetch.Value.ExpireTime <= CurrentTime)
+		{
+			ExpiredPaths.Add(Prefetch.Key);
+		}
+	}
+
+	for (const FSoftObjectPath& ExpiredPath : ExpiredPaths)
+	{
+		ReleasePrefetchADAM(ExpiredPath);
+	}
+
+	if (EnableLog && !ExpiredPaths.IsEmpty())
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Prefetch): %d prefetched Data Assets are not requested in time and are released."), ExpiredPaths.Num());
+	}
+}
+
+FString UAsyncDataAssetManagerSubsystem::GetPrefetchModelFileADAM()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ADAM/PrefetchModelADAM.bin");
+}
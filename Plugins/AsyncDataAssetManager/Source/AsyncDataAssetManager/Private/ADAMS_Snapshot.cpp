@@ -0,0 +1,72 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "AsyncDataAssetManagerSubsystem.h"
+
+FResidencySnapshotRefADAM UAsyncDataAssetManagerSubsystem::AcquireResidencySnapshotADAM() const
+{
+	return ResidencySnapshotChannelADAM.IsValid() ? ResidencySnapshotChannelADAM->Acquire() : FResidencySnapshotRefADAM();
+}
+
+bool UAsyncDataAssetManagerSubsystem::TickResidencySnapshotADAM(float DeltaTime)
+{
+	// All changes of the frame are published together
+	if (!PublishedSnapshotADAM.Snapshot.IsValid() || PublishedSnapshotADAM.Snapshot->GetGeneration() != DataADAM.GetGeneration())
+	{
+		PublishResidencySnapshotADAM();
+	}
+
+	ReclaimResidencySnapshotsADAM();
+
+	return true;
+}
+
+void UAsyncDataAssetManagerSubsystem::PublishResidencySnapshotADAM()
+{
+	TMap<FSoftObjectPath, FResidencySnapshotADAM::FEntry> Entries;
+	Entries.Reserve(DataADAM.Num());
+
+	FPublishedSnapshotADAM NewSnapshot;
+	NewSnapshot.Objects.Reserve(DataADAM.Num());
+
+	// Only the data that has finished loading is resident
+	for (TConstSetBitIterator<> It = DataADAM.CreateConstIterator(); It; ++It)
+	{
+		int32 Slot = It.GetIndex();
+		UObject* LoadedAsset = DataADAM.GetLoadedAsset(Slot);
+
+		if (!LoadedAsset)
+			continue;
+
+		FResidencySnapshotADAM::FEntry& Entry = Entries.Add(DataADAM.GetAssetPath(Slot));
+		Entry.Object = LoadedAsset;
+		Entry.Class = DataADAM.GetClass(Slot);
+		Entry.Owners = DataADAM.GetOwners(Slot);
+
+		NewSnapshot.Objects.Add(LoadedAsset);
+	}
+
+	NewSnapshot.Snapshot = new FResidencySnapshotADAM(DataADAM.GetGeneration(), MoveTemp(Entries));
+
+	// The replaced snapshot is held by the retired one below, the reference of the channel is dropped
+	ResidencySnapshotChannelADAM->Publish(NewSnapshot.Snapshot);
+
+	if (PublishedSnapshotADAM.Snapshot.IsValid())
+	{
+		RetiredSnapshotsADAM.Add(MoveTemp(PublishedSnapshotADAM));
+	}
+
+	PublishedSnapshotADAM = MoveTemp(NewSnapshot);
+}
+
+void UAsyncDataAssetManagerSubsystem::ReclaimResidencySnapshotsADAM()
+{
+	// A reader that has loaded a retired snapshot but not referenced it yet would be missed by the reference count
+	if (RetiredSnapshotsADAM.IsEmpty() || !ResidencySnapshotChannelADAM->IsQuiescent())
+		return;
+
+	// The last reference is the one of the subsystem
+	RetiredSnapshotsADAM.RemoveAll([](const FPublishedSnapshotADAM& RetiredSnapshot)
+	{
+		return RetiredSnapshot.Snapshot->GetRefCount() == 1;
+	});
+}
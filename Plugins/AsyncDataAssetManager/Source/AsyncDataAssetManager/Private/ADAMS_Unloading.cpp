@@ -5,6 +5,7 @@
 #include "Engine/AssetManager.h"
 #include "Engine/DataAsset.h"
 #include "AsyncTechnologiesSettings.h"
+#include "StatsADAM.h"
 
 void UAsyncDataAssetManagerSubsystem::UnloadADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, bool ForcedUnload)
 {
@@ -15,6 +16,11 @@ void UAsyncDataAssetManagerSubsystem::UnloadADAM(TSoftObjectPtr<UPrimaryDataAsse
 		return;
 	}
 
+	if (IsLoadTraceRecording)
+	{
+		RecordTraceADAM(ELoadTraceEventADAM::Unload, { PrimaryDataAsset.ToSoftObjectPath() }, TArray<FName>(), 0, 0, ForcedUnload);
+	}
+
 	if (DataADAM.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("ADAM (Unload): Nothing to delete. The \"DataADAM\" array is empty."));
@@ -33,11 +39,20 @@ void UAsyncDataAssetManagerSubsystem::UnloadADAM(TSoftObjectPtr<UPrimaryDataAsse
 		UE_LOG(LogTemp, Display, TEXT("ADAM (Unload): Unload data asset \"%s\" (index: %d)"), *PrimaryDataAsset.GetAssetName(), TargetIndex);
 	}
 
+	// Data of the tags with a grace period is kept in the cooling pool
+	if (!ForcedUnload && CoolFromADAM(TargetIndex, GetGracePeriodADAM(DataADAM.GetOwners(TargetIndex))))
+		return;
+
 	RemoveFromADAM(TargetIndex, ForcedUnload);
 }
 
 void UAsyncDataAssetManagerSubsystem::UnloadAllADAM(bool ForcedUnload)
 {
+	if (IsLoadTraceRecording)
+	{
+		RecordTraceADAM(ELoadTraceEventADAM::UnloadAll, TArray<FSoftObjectPath>(), TArray<FName>(), 0, 0, ForcedUnload);
+	}
+
 	if (DataADAM.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("ADAM (Unload All ADAM): Nothing to delete. The \"DataADAM\" array is empty."));
@@ -45,20 +60,38 @@ void UAsyncDataAssetManagerSubsystem::UnloadAllADAM(bool ForcedUnload)
 		return;
 	}
 
+	BeginUnloadADAM();
+
 	// Remove all from ADAM
-	for (int32 i = DataADAM.Num() - 1; i >= 0; i--)
+	for (int32 i = DataADAM.GetMaxIndex() - 1; i >= 0; i--)
 	{
+		if (!DataADAM.IsValidIndex(i))
+			continue;
+
 		if (EnableLog)
 		{
 			UE_LOG(LogTemp, Display, TEXT("ADAM (Unload All ADAM): Unload data asset (index: %d)"), i);
 		}
 
+		if (!ForcedUnload && CoolFromADAM(i, GetGracePeriodADAM(DataADAM.GetOwners(i))))
+			continue;
+
 		RemoveFromADAM(i, ForcedUnload);
 	}
+
+	EndUnloadADAM();
 }
 
 void UAsyncDataAssetManagerSubsystem::UnloadAllTagsADAM(FTagContainerADAM Tag, bool ForcedUnload)
 {
+	SCOPE_CYCLE_COUNTER(STAT_UnloadAllTagsADAM);
+
+	// The resolved tags are recorded, so the replay does not depend on the gameplay tag hierarchy
+	if (IsLoadTraceRecording)
+	{
+		RecordTraceADAM(ELoadTraceEventADAM::UnloadAllTags, TArray<FSoftObjectPath>(), GetTagNamesFromContainerADAM(Tag), 0, 0, ForcedUnload);
+	}
+
 	if (DataADAM.Num() == 0)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("ADAM (Unload All Tags ADAM): Nothing to delete. The \"DataADAM\" array is empty."));
@@ -66,49 +99,255 @@ void UAsyncDataAssetManagerSubsystem::UnloadAllTagsADAM(FTagContainerADAM Tag, b
 		return;
 	}
 
-	TArray<FName> TagNameContainerCache;
+	TArray<FName> TagNameContainerCache = GetTagNamesFromContainerADAM(Tag);
+
+	// Collect the handles of all data with a similar target tag. Only the buckets of the requested tags are visited.
+	TArray<FHandleADAM> TargetHandles;
+
+	for (FName TagName : TagNameContainerCache)
+	{
+		if (const TSet<int32>* TagBucket = DataADAM.FindTagBucket(TagName))
+		{
+			for (int32 TargetIndex : *TagBucket)
+			{
+				TargetHandles.Add(DataADAM.GetHandle(TargetIndex));
+			}
+		}
+	}
+
+	// Unloading in descending order
+	TargetHandles.Sort([](const FHandleADAM& A, const FHandleADAM& B) { return A.Index > B.Index; });
+
+	BeginUnloadADAM();
+
+	int32 PreviousIndex = INDEX_NONE;
+
+	for (const FHandleADAM& TargetHandle : TargetHandles)
+	{
+		// The same tag can be requested several times. A slot freed during the unload is skipped, even if it is reused.
+		if (TargetHandle.Index == PreviousIndex || !DataADAM.IsValidHandle(TargetHandle))
+			continue;
+
+		int32 TargetIndex = TargetHandle.Index;
+		PreviousIndex = TargetIndex;
+
+		FSoftObjectPath DataAssetPath = DataADAM.GetAssetPath(TargetIndex);
+		float GracePeriod = ForcedUnload ? 0.0f : GetGracePeriodADAM(DataADAM.GetOwners(TargetIndex));
+
+		for (FName TagName : TagNameContainerCache)
+		{
+			if (DataADAM.RemoveOwner(TargetIndex, TagName))
+			{
+				DetachInFlightADAM(DataAssetPath, TagName);
+			}
+		}
+
+		if (!DataADAM.IsValidHandle(TargetHandle))
+			continue;
+
+		// Shared data stays in memory until its last owner is unloaded
+		if (DataADAM.GetNumOwners(TargetIndex) != 0)
+		{
+			if (EnableLog)
+			{
+				UE_LOG(LogTemp, Display, TEXT("ADAM (Unload All Tags ADAM): Data asset \"%s\" is kept, it is still owned by %d tags."), *DataAssetPath.GetAssetName(), DataADAM.GetNumOwners(TargetIndex));
+			}
+
+			continue;
+		}
+
+		if (EnableLog)
+		{
+			UE_LOG(LogTemp, Display, TEXT("ADAM (Unload All Tags ADAM): Unload data asset \"%s\" (index: %d)"), *DataAssetPath.GetAssetName(), TargetIndex);
+		}
+
+		// A reload of the area within the grace period is served from the cooling pool
+		if (CoolFromADAM(TargetIndex, GracePeriod))
+			continue;
+
+		RemoveFromADAM(TargetIndex, ForcedUnload);
+	}
+
+	EndUnloadADAM();
+}
+
+void UAsyncDataAssetManagerSubsystem::DetachInFlightADAM(const FSoftObjectPath& AssetPath, FName Tag)
+{
+	FInFlightADAM* InFlight = InFlightADAM.Find(AssetPath);
+
+	if (!InFlight)
+		return;
 
-	// Determines the type of string and returns it to the FName array.
-	if (!Tag.GameplayTags.IsEmpty())
+	// Notifications of removed requesters are no longer expected
+	TArray<int32> CancelledBatchIds;
+	TArray<int32> CancelledRequestIds;
+
+	for (int32 i = InFlight->Requesters.Num() - 1; i >= 0; i--)
 	{
-		TArray<FGameplayTag> GameplayTagContainer = Tag.GameplayTags.GetGameplayTagArray();
-		// Convert tags to FName.
-		for (FGameplayTag GameplayTag : GameplayTagContainer)
+		const FInFlightRequesterADAM& Requester = InFlight->Requesters[i];
+
+		if (Requester.Tag != Tag)
+			continue;
+
+		if (Requester.BatchId != 0)
 		{
-			TagNameContainerCache.Add(GameplayTag.GetTagName());
+			CancelledBatchIds.Add(Requester.BatchId);
 		}
+
+		if (Requester.RequestId != 0)
+		{
+			CancelledRequestIds.Add(Requester.RequestId);
+		}
+
+		InFlight->Requesters.RemoveAt(i, EAllowShrinking::No);
 	}
-	
-	if (Tag.TagNameContainer.Num() != 0)
+
+	// The array loads complete without this Data Asset
+	for (int32 CancelledBatchId : CancelledBatchIds)
 	{
-		TagNameContainerCache.Append(Tag.TagNameContainer);
+		ResolveLoadBatchADAM(CancelledBatchId, AssetPath);
 	}
-	
-	if (!Tag.TagName.IsNone())
+
+	for (int32 CancelledRequestId : CancelledRequestIds)
 	{
-		TagNameContainerCache.Add(Tag.TagName);
+		ReleaseNativeRequesterADAM(CancelledRequestId);
 	}
+}
 
-	// Set default value if no other data
-	if (TagNameContainerCache.Num() == 0)
+void UAsyncDataAssetManagerSubsystem::CancelInFlightADAM(const FSoftObjectPath& AssetPath)
+{
+	FInFlightADAM InFlight;
+
+	if (!InFlightADAM.RemoveAndCopyValue(AssetPath, InFlight))
+		return;
+
+	IsQueueChanged = true;
+
+	// Stop loading. A batch keeps loading the other Data Assets.
+	if (InFlight.StreamableHandle.IsValid())
 	{
-		TagNameContainerCache.Add(NAME_None);
+		InFlight.StreamableHandle->ReleaseHandle();
 	}
 
-	// Remove of all data with a similar target tag
-	for (FName TagName : TagNameContainerCache)
+	for (const FInFlightRequesterADAM& Requester : InFlight.Requesters)
 	{
-		for (int32 i = DataADAM.Num() - 1; i >= 0; i--)
+		// The array load completes without this Data Asset
+		if (Requester.BatchId != 0)
 		{
-			if (DataADAM[i].Tag == TagName)
-			{
-				if (EnableLog)
-				{
-					UE_LOG(LogTemp, Display, TEXT("ADAM (Unload All Tags ADAM): Unload data asset \"%s\" (index: %d)"), *DataADAM[i].SoftReference.GetAssetName(), i);
-				}
+			ResolveLoadBatchADAM(Requester.BatchId, AssetPath);
+		}
+
+		// The native request completes without this Data Asset
+		if (Requester.RequestId != 0)
+		{
+			ReleaseNativeRequesterADAM(Requester.RequestId);
+		}
+	}
+}
 
-				RemoveFromADAM(i, ForcedUnload);
+void UAsyncDataAssetManagerSubsystem::CancelBatchADAM(int32 BatchId)
+{
+	FLoadBatchADAM LoadBatch;
+
+	// No notification is sent for the cancelled array load, pending nested data searches find it missing and are skipped
+	if (!LoadBatchesADAM.RemoveAndCopyValue(BatchId, LoadBatch))
+	{
+		if (EnableLog)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ADAM (Cancel Batch): Array load %d is not in progress."), BatchId);
+		}
+
+		return;
+	}
+
+	TSet<int32> AffectedBatchKeys;
+	int32 NumCancelled = 0;
+
+	// Array loads completed by the cancelled requests are reported after the loop
+	BeginUnloadADAM();
+
+	for (const FSoftObjectPath& DataAssetPath : LoadBatch.PendingPaths)
+	{
+		FInFlightADAM* InFlight = InFlightADAM.Find(DataAssetPath);
+
+		// Loaded data waiting for post-load processing stays in memory
+		if (!InFlight)
+			continue;
+
+		if (InFlight->BatchKey != 0)
+		{
+			AffectedBatchKeys.Add(InFlight->BatchKey);
+		}
+
+		InFlight->Requesters.RemoveAll([BatchId](const FInFlightRequesterADAM& Requester) { return Requester.BatchId == BatchId; });
+
+		int32 TargetIndex = DataADAM.FindSlot(DataAssetPath);
+
+		// Nobody else waits for the Data Asset, so its request is cancelled together with the entry
+		if (InFlight->Requesters.IsEmpty())
+		{
+			if (TargetIndex != INDEX_NONE)
+			{
+				RemoveFromADAM(TargetIndex, false);
+			}
+			else
+			{
+				CancelInFlightADAM(DataAssetPath);
 			}
+
+			NumCancelled++;
+
+			continue;
+		}
+
+		// Other requests keep loading the Data Asset, the tag of the array load only loses the ownership if none of them is its own
+		bool bIsRequestedByTag = InFlight->Requesters.ContainsByPredicate([&LoadBatch](const FInFlightRequesterADAM& Requester) { return Requester.Tag == LoadBatch.Tag; });
+
+		if (!bIsRequestedByTag && TargetIndex != INDEX_NONE)
+		{
+			DataADAM.RemoveOwner(TargetIndex, LoadBatch.Tag);
+		}
+	}
+
+	// Batches without Data Assets to load stop their IO
+	ReleaseIdleBatchHandlesADAM(AffectedBatchKeys);
+
+	// A cancelled preload entry doesn't hold back the rest of the startup preload
+	CompletePreloadBatchADAM(BatchId);
+
+	EndUnloadADAM();
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Cancel Batch): Array load %d is cancelled, %d requests are stopped."), BatchId, NumCancelled);
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::ReleaseIdleBatchHandlesADAM(const TSet<int32>& BatchKeys)
+{
+	if (BatchKeys.IsEmpty())
+		return;
+
+	TSet<int32> ActiveBatchKeys;
+
+	for (const TPair<FSoftObjectPath, FInFlightADAM>& InFlight : InFlightADAM)
+	{
+		if (InFlight.Value.BatchKey != 0)
+		{
+			ActiveBatchKeys.Add(InFlight.Value.BatchKey);
+		}
+	}
+
+	for (int32 BatchKey : BatchKeys)
+	{
+		if (ActiveBatchKeys.Contains(BatchKey))
+			continue;
+
+		TSharedPtr<FStreamableHandle> BatchHandle;
+
+		if (BatchHandlesADAM.RemoveAndCopyValue(BatchKey, BatchHandle) && BatchHandle.IsValid())
+		{
+			BatchHandle->CancelHandle();
 		}
 	}
 }
@@ -119,14 +358,23 @@ void UAsyncDataAssetManagerSubsystem::RemoveFromADAM(int32 DataAssetIndex, bool
 	if (DataADAM.IsValidIndex(DataAssetIndex))
 	{
 		// Release Handle and tell the system that the data in memory is no longer needed
-		DataADAM[DataAssetIndex].MemoryReference->ReleaseHandle();
+		TSharedPtr<FStreamableHandle>& DataAssetHandle = DataADAM.GetStreamableHandle(DataAssetIndex);
+
+		ReleaseStreamableHandleADAM(DataAssetHandle);
+
 		if (ForcedUnload)
 		{
-			DataADAM[DataAssetIndex].MemoryReference.Reset();
+			DataAssetHandle.Reset();
 		}
 
-		// Remove the target element from the main array
+		FSoftObjectPath DataAssetPath = DataADAM.GetAssetPath(DataAssetIndex);
+
+		// Remove the target element from the main storage. Other elements keep their slots.
 		DataADAM.RemoveAt(DataAssetIndex);
+
+		// Nothing keeps the Data Asset anymore, so a load in progress is cancelled
+		CancelInFlightADAM(DataAssetPath);
+		ReleasePrimaryBundlesADAM(DataAssetPath);
 	}
 	else
 	{
@@ -135,3 +383,141 @@ void UAsyncDataAssetManagerSubsystem::RemoveFromADAM(int32 DataAssetIndex, bool
 		return;
 	}
 }
+
+void UAsyncDataAssetManagerSubsystem::SetGracePeriodADAM(FTagADAM Tag, float GracePeriod)
+{
+	GracePeriods.Add(GetTagNameFromStruct(Tag), FMath::Max(GracePeriod, 0.0f));
+}
+
+bool UAsyncDataAssetManagerSubsystem::IsCoolingADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset)
+{
+	return CoolingADAM.Contains(PrimaryDataAsset.ToSoftObjectPath());
+}
+
+void UAsyncDataAssetManagerSubsystem::ClearCoolingADAM()
+{
+	TArray<FSoftObjectPath> CoolingPaths;
+	CoolingADAM.GetKeys(CoolingPaths);
+
+	for (const FSoftObjectPath& CoolingPath : CoolingPaths)
+	{
+		ReleaseCoolingADAM(CoolingPath);
+	}
+}
+
+float UAsyncDataAssetManagerSubsystem::GetGracePeriodADAM(const TArray<FName>& Tags) const
+{
+	float GracePeriod = 0.0f;
+
+	for (FName Tag : Tags)
+	{
+		const float* TagGracePeriod = GracePeriods.Find(Tag);
+		GracePeriod = FMath::Max(GracePeriod, TagGracePeriod ? *TagGracePeriod : DefaultGracePeriod);
+	}
+
+	return GracePeriod;
+}
+
+bool UAsyncDataAssetManagerSubsystem::CoolFromADAM(int32 DataAssetIndex, float GracePeriod)
+{
+	if (GracePeriod <= 0.0f || !DataADAM.IsValidIndex(DataAssetIndex))
+		return false;
+
+	FSoftObjectPath DataAssetPath = DataADAM.GetAssetPath(DataAssetIndex);
+	TSharedPtr<FStreamableHandle>& DataAssetHandle = DataADAM.GetStreamableHandle(DataAssetIndex);
+
+	// Only loaded data can be kept. A load in progress is cancelled as usual.
+	if (!DataAssetHandle.IsValid() || !DataAssetHandle->HasLoadCompleted() || InFlightADAM.Contains(DataAssetPath))
+		return false;
+
+	FCoolingADAM& Cooling = CoolingADAM.Add(DataAssetPath);
+	Cooling.StreamableHandle = MoveTemp(DataAssetHandle);
+	Cooling.ExpireTime = FPlatformTime::Seconds() + GracePeriod;
+	Cooling.ResidentSize = DataADAM.GetResidentSize(DataAssetIndex);
+	Cooling.Priority = DataADAM.GetPriority(DataAssetIndex);
+
+	if (Cooling.ResidentSize != INDEX_NONE)
+	{
+		CoolingResidentSize += Cooling.ResidentSize;
+	}
+
+	// The entry is removed from the storage, the descriptor is held by the pool
+	DataADAM.RemoveAt(DataAssetIndex);
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Cooling): Data asset \"%s\" is kept in the cooling pool for %.1f s."), *DataAssetPath.GetAssetName(), GracePeriod);
+	}
+
+	return true;
+}
+
+void UAsyncDataAssetManagerSubsystem::ReleaseCoolingADAM(const FSoftObjectPath& AssetPath)
+{
+	FCoolingADAM Cooling;
+
+	if (!CoolingADAM.RemoveAndCopyValue(AssetPath, Cooling))
+		return;
+
+	if (Cooling.ResidentSize != INDEX_NONE)
+	{
+		CoolingResidentSize -= Cooling.ResidentSize;
+	}
+
+	// Tell the system that the data in memory is no longer needed
+	ReleaseStreamableHandleADAM(Cooling.StreamableHandle);
+
+	ReleasePrimaryBundlesADAM(AssetPath);
+
+	if (EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Cooling): Data asset \"%s\" is released from the cooling pool."), *AssetPath.GetAssetName());
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::TickCoolingADAM()
+{
+	if (CoolingADAM.IsEmpty())
+		return;
+
+	double CurrentTime = FPlatformTime::Seconds();
+	TArray<FSoftObjectPath> ExpiredPaths;
+
+	for (const TPair<FSoftObjectPath, FCoolingADAM>& Cooling : CoolingADAM)
+	{
+		if (Cooling.Value.ExpireTime <= CurrentTime)
+		{
+			ExpiredPaths.Add(Cooling.Key);
+		}
+	}
+
+	for (const FSoftObjectPath& ExpiredPath : ExpiredPaths)
+	{
+		ReleaseCoolingADAM(ExpiredPath);
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::EvictCoolingADAM(int64 TargetResidentSize)
+{
+	if (CoolingADAM.IsEmpty() || DataADAM.GetTotalResidentSize() + CoolingResidentSize <= TargetResidentSize)
+		return;
+
+	// Data that expires first is released first
+	TArray<TPair<double, FSoftObjectPath>> CoolingOrder;
+	CoolingOrder.Reserve(CoolingADAM.Num());
+
+	for (const TPair<FSoftObjectPath, FCoolingADAM>& Cooling : CoolingADAM)
+	{
+		CoolingOrder.Emplace(Cooling.Value.ExpireTime, Cooling.Key);
+	}
+
+	CoolingOrder.Sort([](const TPair<double, FSoftObjectPath>& A, const TPair<double, FSoftObjectPath>& B) { return A.Key < B.Key; });
+
+	for (const TPair<double, FSoftObjectPath>& Cooling : CoolingOrder)
+	{
+		if (DataADAM.GetTotalResidentSize() + CoolingResidentSize <= TargetResidentSize)
+			break;
+
+		ReleaseCoolingADAM(Cooling.Value);
+	}
+}
@@ -2,17 +2,38 @@
 
 #include "AsyncDataAssetManager.h"
 
+#include "UObject/UObjectGlobals.h"
+#include "NestedAssetsPlanADAM.h"
+
 #define LOCTEXT_NAMESPACE "FAsyncDataAssetManagerModule"
 
 void FAsyncDataAssetManagerModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+#if WITH_EDITOR
+	// Reinstanced and reloaded types can have a new layout, their soft-reference plans are built again on the next use
+	ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddLambda([](const FCoreUObjectDelegates::FReplacementObjectMap&)
+	{
+		FNestedAssetsPlanADAM::ResetCache();
+	});
+
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([](EReloadCompleteReason)
+	{
+		FNestedAssetsPlanADAM::ResetCache();
+	});
+#endif
 }
 
 void FAsyncDataAssetManagerModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
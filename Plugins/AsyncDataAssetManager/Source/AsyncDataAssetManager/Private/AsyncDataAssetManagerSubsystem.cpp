@@ -5,6 +5,11 @@
 #include "Engine/AssetManager.h"
 #include "Engine/DataAsset.h"
 #include "AsyncTechnologiesSettings.h"
+#include "Misc/Paths.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/CoreDelegates.h"
+#include "StatsADAM.h"
 
 #pragma region SUBSYSTEM
 // Initialize subsystem
@@ -15,6 +20,95 @@ void UAsyncDataAssetManagerSubsystem::Initialize(FSubsystemCollectionBase& Colle
 	// Get the list of settings for the ADAM subsystem 
 	const UAsyncTechnologiesSettings* SettingsADAM = GetDefault<UAsyncTechnologiesSettings>();
 	EnableLog = SettingsADAM->bEnableLogADAM;
+	BatchArrayLoading = SettingsADAM->bBatchArrayLoadingADAM;
+	RecursivePriorityDecay = SettingsADAM->RecursivePriorityDecayADAM;
+	PostLoadFrameBudget = SettingsADAM->PostLoadFrameBudgetADAM;
+	NestedDiscovery = SettingsADAM->NestedDiscoveryADAM;
+	MemoryBudget = int64(SettingsADAM->MemoryBudgetADAM) * 1024 * 1024;
+	MemoryPressureTarget = SettingsADAM->MemoryPressureTargetADAM;
+	DefaultEvictionTier = SettingsADAM->DefaultEvictionTierADAM;
+	EvictionTiers = SettingsADAM->EvictionTiersADAM;
+	DefaultGracePeriod = SettingsADAM->DefaultGracePeriodADAM;
+	GracePeriods = SettingsADAM->GracePeriodsADAM;
+	PredictivePrefetch = SettingsADAM->bPredictivePrefetchADAM;
+	PrefetchThreshold = SettingsADAM->PrefetchThresholdADAM;
+	PrefetchPriority = SettingsADAM->PrefetchPriorityADAM;
+	PrefetchLifetime = SettingsADAM->PrefetchLifetimeADAM;
+	PrefetchAssetsPerTag = FMath::Max(SettingsADAM->PrefetchAssetsPerTagADAM, 1);
+	ResidencySnapshot = SettingsADAM->bResidencySnapshotADAM;
+	PerAssetLoadEvent = SettingsADAM->bPerAssetLoadEventADAM;
+
+	if (NestedDiscovery == ENestedDiscoveryADAM::Manifest)
+	{
+		FString ManifestFile = FPaths::ProjectContentDir() / SettingsADAM->NestedManifestPathADAM;
+
+		if (!NestedManifestADAM.LoadFromFile(ManifestFile))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ADAM (Initialize): Nested manifest \"%s\" can't be loaded. Nested data will be searched after each load."), *ManifestFile);
+
+			NestedDiscovery = ENestedDiscoveryADAM::Reflection;
+		}
+		else
+		{
+#if WITH_EDITOR
+			// Data Assets saved after the generation can have new nested data, their closures are searched after loading instead
+			IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+			int32 NumStaleClosures = NestedManifestADAM.RemoveStaleClosures([&AssetRegistry](const FSoftObjectPath& AssetPath)
+			{
+				TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(AssetPath.GetLongPackageFName());
+
+				return PackageData.IsSet() ? PackageData->GetPackageSavedHash() : FIoHash();
+			});
+
+			if (NumStaleClosures > 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ADAM (Initialize): %d Data Assets of the nested manifest have changed since it was generated, their nested data will be searched after loading. Regenerate the manifest with \"-run=NestedManifestADAM\"."), NumStaleClosures);
+			}
+#endif
+
+			if (EnableLog)
+			{
+				UE_LOG(LogTemp, Display, TEXT("ADAM (Initialize): Nested manifest with %d Data Assets is loaded."), NestedManifestADAM.Num());
+			}
+		}
+	}
+	else if (NestedDiscovery == ENestedDiscoveryADAM::AssetRegistry)
+	{
+		// Includes Blueprint classes derived from UPrimaryDataAsset
+		TArray<FTopLevelAssetPath> BaseClassPaths;
+		BaseClassPaths.Add(UPrimaryDataAsset::StaticClass()->GetClassPathName());
+
+		IAssetRegistry::GetChecked().GetDerivedClassNames(BaseClassPaths, TSet<FTopLevelAssetPath>(), PrimaryDataAssetClassPaths);
+		PrimaryDataAssetClassPaths.Append(BaseClassPaths);
+	}
+
+	// Load sequences of the previous sessions
+	if (PredictivePrefetch && PrefetchModelADAM.LoadFromFile(GetPrefetchModelFileADAM()) && EnableLog)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Initialize): Prefetch model with %d tags is loaded."), PrefetchModelADAM.Num());
+	}
+
+	// Post-load processing of completed loads
+	PostLoadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAsyncDataAssetManagerSubsystem::TickPostLoad));
+
+	// Published after the post-load processing of the frame
+	if (ResidencySnapshot)
+	{
+		ResidencySnapshotChannelADAM = MakeShared<FResidencySnapshotChannelADAM, ESPMode::ThreadSafe>();
+		SnapshotTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAsyncDataAssetManagerSubsystem::TickResidencySnapshotADAM));
+	}
+
+	// Low memory notification of the operating system
+	MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddUObject(this, &UAsyncDataAssetManagerSubsystem::OnMemoryPressureADAM);
+
+	if (SettingsADAM->bRecordLoadTraceADAM)
+	{
+		StartLoadTraceADAM();
+	}
+
+	// Critical data is requested before the first map starts loading
+	PreloadADAM(SettingsADAM->PreloadADAM, SettingsADAM->PreloadPriorityADAM);
 }
 
 // Freeing memory during deinitialization
@@ -22,21 +116,248 @@ void UAsyncDataAssetManagerSubsystem::Deinitialize()
 {
 	Super::Deinitialize();
 
+	// The unloads of the shutdown are not part of the session
+	if (IsLoadTraceRecording)
+	{
+		StopLoadTraceADAM(FString());
+	}
+
+	FTSTicker::GetCoreTicker().RemoveTicker(PostLoadTickerHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(SnapshotTickerHandle);
+	FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+	PostLoadQueueADAM.Empty();
+	PostLoadQueueHead = 0;
+
+	// Pending notifications are dropped together with the loads in progress
+	LoadBatchesADAM.Empty();
+	PreloadBatchIdsADAM.Empty();
+
 	if (!DataADAM.IsEmpty())
 	{
 		// Clearing saved TSharedPtr<FStreamableHandle>
 		UnloadAllADAM(true);
 	}
 
+	// Cancel batches that are still in progress
+	for (TPair<int32, TSharedPtr<FStreamableHandle>>& BatchHandle : BatchHandlesADAM)
+	{
+		if (BatchHandle.Value.IsValid())
+		{
+			BatchHandle.Value->ReleaseHandle();
+		}
+	}
+
+	BatchHandlesADAM.Empty();
+	SharedHandlesADAM.Empty();
+	InFlightADAM.Empty();
+	QueueADAM.Empty();
+	IsQueueChanged = false;
+	NativeRequestsADAM.Empty();
+	ClearCoolingADAM();
+	ClearPrefetchADAM();
+
+	if (PredictivePrefetch)
+	{
+		if (EnableLog)
+		{
+			FPrefetchStatsADAM Stats = GetPrefetchStatsADAM();
+			UE_LOG(LogTemp, Display, TEXT("ADAM (Prefetch): %d predictions, %d of %d prefetched Data Assets are requested (accuracy %.2f), %lld bytes are wasted."), Stats.NumPredictions, Stats.NumHits, Stats.NumPrefetched, Stats.Accuracy, Stats.WastedBytes);
+		}
+
+		PrefetchModelADAM.SaveToFile(GetPrefetchModelFileADAM());
+		PrefetchModelADAM.Empty();
+	}
+	PrimaryBundlesADAM.Empty();
+	NestedManifestADAM.Empty();
+	PrimaryDataAssetClassPaths.Empty();
+
+	// Readers still holding a snapshot keep its memory, but its objects are no longer kept alive
+	if (ResidencySnapshotChannelADAM.IsValid())
+	{
+		ResidencySnapshotChannelADAM->Publish(nullptr);
+		RetiredSnapshotsADAM.Add(MoveTemp(PublishedSnapshotADAM));
+
+		// A reader can be taking a reference to the withdrawn snapshot, the window is a few instructions long
+		while (!ResidencySnapshotChannelADAM->IsQuiescent())
+		{
+			FPlatformProcess::Yield();
+		}
+
+		int32 NumHeldSnapshots = RetiredSnapshotsADAM.FilterByPredicate([](const FPublishedSnapshotADAM& Retired) { return Retired.Snapshot.IsValid() && Retired.Snapshot->GetRefCount() > 1; }).Num();
+
+		if (NumHeldSnapshots > 0)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ADAM (Deinitialize): %d residency snapshots are still held by readers. Release them before the game instance shuts down."), NumHeldSnapshots);
+		}
+
+		PublishedSnapshotADAM = FPublishedSnapshotADAM();
+		RetiredSnapshotsADAM.Empty();
+	}
+
 	OnLoadedADAM.Clear();
 	OnAllLoadedADAM.Clear();
+	OnBatchLoadedADAM.Clear();
+	OnPreloadedADAM.Clear();
+	OnFrameLoadedADAM.Clear();
+	OnEvictedADAM.Clear();
+	OnBundleStateChangedADAM.Clear();
+}
+
+void UAsyncDataAssetManagerSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	UAsyncDataAssetManagerSubsystem* This = CastChecked<UAsyncDataAssetManagerSubsystem>(InThis);
+
+	// Objects of the published snapshots stay valid for the readers, even after the data is unloaded
+	Collector.AddReferencedObjects(This->PublishedSnapshotADAM.Objects);
+
+	for (FPublishedSnapshotADAM& RetiredSnapshot : This->RetiredSnapshotsADAM)
+	{
+		Collector.AddReferencedObjects(RetiredSnapshot.Objects);
+	}
+
+	Super::AddReferencedObjects(InThis, Collector);
 }
 
 #pragma endregion SUBSYSTEM
 
 #pragma region CALL_DELEGATE
-void UAsyncDataAssetManagerSubsystem::OnLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading)
+void UAsyncDataAssetManagerSubsystem::OnStreamableLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, bool NotifyAfterFullLoaded, int32 RequestId, int32 BatchId, bool IsNestedRequested)
 {
+	// Nested asset search, notifications and queue cleanup are deferred to the post-load tick
+	FPostLoadADAM& PostLoad = PostLoadQueueADAM.AddDefaulted_GetRef();
+	PostLoad.SoftReference = PrimaryDataAsset;
+	PostLoad.Tag = Tag;
+	PostLoad.RecursiveDepthLoading = RecursiveDepthLoading;
+	PostLoad.Priority = Priority;
+	PostLoad.NotifyAfterFullLoaded = NotifyAfterFullLoaded;
+	PostLoad.RequestId = RequestId;
+	PostLoad.BatchId = BatchId;
+	PostLoad.IsNestedRequested = IsNestedRequested;
+}
+
+bool UAsyncDataAssetManagerSubsystem::TickPostLoad(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TickPostLoadADAM);
+
+	// Grace periods of the cooling pool and lifetimes of the prefetched data are checked every frame
+	TickCoolingADAM();
+	TickPrefetchADAM();
+
+	UpdateStatsADAM();
+
+	// The Blueprint mirror of the in-flight table is rebuilt once per frame instead of on every request
+	if (IsQueueChanged)
+	{
+		IsQueueChanged = false;
+		QueueADAM.Reset(InFlightADAM.Num());
+
+		for (const TPair<FSoftObjectPath, FInFlightADAM>& InFlight : InFlightADAM)
+		{
+			QueueADAM.Add(InFlight.Key.GetAssetName());
+		}
+	}
+
+	if (PostLoadQueueHead == PostLoadQueueADAM.Num())
+		return true;
+
+	double StartTime = FPlatformTime::Seconds();
+	double TimeBudget = PostLoadFrameBudget / 1000.0;
+
+	TArray<FMirrorADAM> FrameLoadedDataAssets;
+
+	// The frame notification is only built for listeners
+	bool bReportFrame = OnFrameLoadedADAM.IsBound();
+
+	// New loads can be added to the queue during processing, they are handled in the same pass if the budget allows
+	while (PostLoadQueueHead < PostLoadQueueADAM.Num())
+	{
+		FPostLoadADAM PostLoad = PostLoadQueueADAM[PostLoadQueueHead++];
+
+		// Data of a cancelled array load stays stored, but is not reported and its nested data is not searched.
+		// Its residency is still registered, so it is measured for the memory budget and found by the getters.
+		if (PostLoad.BatchId != 0 && !LoadBatchesADAM.Contains(PostLoad.BatchId))
+		{
+			UpdateResidencyADAM(GetIndexDataADAM(PostLoad.SoftReference));
+
+			continue;
+		}
+
+		// Native requests are reported to their own callbacks only
+		if (PostLoad.RequestId != 0)
+		{
+			OnNativeLoaded(PostLoad);
+		}
+		else if (!PostLoad.NotifyAfterFullLoaded)
+		{
+			OnLoaded(PostLoad.SoftReference, PostLoad.Tag, PostLoad.RecursiveDepthLoading, PostLoad.Priority, PostLoad.BatchId, PostLoad.IsNestedRequested);
+		}
+		else
+		{
+			OnAllLoaded(PostLoad.SoftReference, PostLoad.Tag, PostLoad.RecursiveDepthLoading, PostLoad.Priority, PostLoad.BatchId, PostLoad.IsNestedRequested);
+		}
+
+		// The nested data search of the Data Asset is already registered in its array load
+		ResolveLoadBatchADAM(PostLoad.BatchId, PostLoad.SoftReference.ToSoftObjectPath());
+
+		if (bReportFrame && PostLoad.SoftReference.Get())
+		{
+			FMirrorADAM& MirrorDataAsset = FrameLoadedDataAssets.AddDefaulted_GetRef();
+			MirrorDataAsset.PrimaryDataAssetName = PostLoad.SoftReference.GetAssetName();
+			MirrorDataAsset.SoftReference = PostLoad.SoftReference;
+			MirrorDataAsset.Tag = PostLoad.Tag;
+		}
+
+		// At least one load is processed per frame. If the budget is '0', the queue is processed completely.
+		if (TimeBudget > 0.0 && FPlatformTime::Seconds() - StartTime >= TimeBudget)
+			break;
+	}
+
+	int32 NumDeferred = PostLoadQueueADAM.Num() - PostLoadQueueHead;
+
+	// Processed loads are dropped without moving the backlog each frame. The backlog is moved only once it is shorter than the processed part.
+	if (NumDeferred == 0)
+	{
+		PostLoadQueueADAM.Reset();
+		PostLoadQueueHead = 0;
+	}
+	else if (PostLoadQueueHead >= NumDeferred)
+	{
+		PostLoadQueueADAM.RemoveAt(0, PostLoadQueueHead, EAllowShrinking::No);
+		PostLoadQueueHead = 0;
+	}
+
+	if (EnableLog && NumDeferred > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Post Load): Frame budget is exhausted, %d Data Assets are deferred to the next frame."), NumDeferred);
+	}
+
+	// Inform the FOnFrameLoadedADAM subsystem delegate about all loads of the frame
+	if (!FrameLoadedDataAssets.IsEmpty())
+	{
+		OnFrameLoadedADAM.Broadcast(FrameLoadedDataAssets);
+	}
+
+	// Newly measured data can exceed the memory budget
+	EnforceMemoryBudgetADAM();
+
+	return true;
+}
+
+void UAsyncDataAssetManagerSubsystem::UpdateStatsADAM()
+{
+	SET_DWORD_STAT(STAT_NumStoredADAM, DataADAM.Num());
+	SET_DWORD_STAT(STAT_NumInFlightADAM, InFlightADAM.Num());
+	SET_DWORD_STAT(STAT_NumPostLoadADAM, PostLoadQueueADAM.Num() - PostLoadQueueHead);
+	SET_DWORD_STAT(STAT_NumLoadBatchesADAM, LoadBatchesADAM.Num());
+	SET_DWORD_STAT(STAT_NumCoolingADAM, CoolingADAM.Num());
+	SET_MEMORY_STAT(STAT_ResidentSizeADAM, DataADAM.GetTotalResidentSize());
+	SET_MEMORY_STAT(STAT_CoolingResidentSizeADAM, CoolingResidentSize);
+}
+
+void UAsyncDataAssetManagerSubsystem::OnLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId, bool IsNestedRequested)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OnLoadedADAM);
+
 	UPrimaryDataAsset* LoadedObject =	PrimaryDataAsset.Get();
 
 	if (!LoadedObject)
@@ -46,25 +367,30 @@ void UAsyncDataAssetManagerSubsystem::OnLoaded(TSoftObjectPtr<UPrimaryDataAsset>
 		return;
 	}
 
+	UpdateResidencyADAM(GetIndexDataADAM(PrimaryDataAsset));
+
 	// Inform the FOnLoadedADAM subsystem delegate that the loading is complete
-	OnLoadedADAM.Broadcast(LoadedObject, PrimaryDataAsset, Tag, RecursiveDepthLoading);
+	if (PerAssetLoadEvent && OnLoadedADAM.IsBound())
+	{
+		OnLoadedADAM.Broadcast(LoadedObject, PrimaryDataAsset, Tag, RecursiveDepthLoading);
+	}
 
-	if (RecursiveDepthLoading != 0 && FindNestedAssets(LoadedObject).Num() != 0)
+	// Nested data is searched once, on a worker thread
+	if (RecursiveDepthLoading != 0 && !IsNestedRequested)
 	{
-		RecursiveLoad(PrimaryDataAsset, Tag, false, RecursiveDepthLoading);
+		FindNestedAssetsAsync(PrimaryDataAsset, Tag, false, RecursiveDepthLoading, Priority, BatchId);
 	}
 
 	if (EnableLog)
 	{
 		UE_LOG(LogTemp, Display, TEXT("ADAM (On Loaded): Data Asset \"%s\" is loaded."), *PrimaryDataAsset.GetAssetName());
 	}
-
-	// Clear Queue
-	QueueADAM.Remove(PrimaryDataAsset.GetAssetName());
 }
 
-void UAsyncDataAssetManagerSubsystem::OnAllLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading)
+void UAsyncDataAssetManagerSubsystem::OnAllLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId, bool IsNestedRequested)
 {
+	SCOPE_CYCLE_COUNTER(STAT_OnLoadedADAM);
+
 	UPrimaryDataAsset* LoadedObject =	PrimaryDataAsset.Get();
 
 	if (!LoadedObject)
@@ -74,33 +400,187 @@ void UAsyncDataAssetManagerSubsystem::OnAllLoaded(TSoftObjectPtr<UPrimaryDataAss
 		return;
 	}
 
-	if (RecursiveDepthLoading != 0 && FindNestedAssets(LoadedObject).Num() != 0)
+	UpdateResidencyADAM(GetIndexDataADAM(PrimaryDataAsset));
+
+	// Nested data is searched once, on a worker thread
+	if (RecursiveDepthLoading != 0 && !IsNestedRequested)
 	{
-		RecursiveLoad(PrimaryDataAsset, Tag, true, RecursiveDepthLoading);
+		FindNestedAssetsAsync(PrimaryDataAsset, Tag, true, RecursiveDepthLoading, Priority, BatchId);
 	}
 
 	if (EnableLog)
 	{
 		UE_LOG(LogTemp, Display, TEXT("ADAM (On All Loaded): Data Asset \"%s\" is loaded."), *PrimaryDataAsset.GetAssetName());
 	}
+}
+
+void UAsyncDataAssetManagerSubsystem::OnBatchLoaded(int32 BatchKey, TArray<FSoftObjectPath> BatchPaths)
+{
+	// The descriptor is missing if the batch completed before the request returned
+	TSharedPtr<FStreamableHandle> BatchHandle;
+	BatchHandlesADAM.RemoveAndCopyValue(BatchKey, BatchHandle);
 
-	if (QueueCounterADAM.Contains(Tag))
+	// The batch holds itself while its entries are notified, so an entry unloaded by a notification can't release it early
+	if (BatchHandle.IsValid())
 	{
-		QueueCounterADAM[Tag]--;
+		SharedHandlesADAM.Add(BatchHandle.Get(), 1);
+	}
+
+	// Data Assets unloaded while the batch was in progress are no longer in the in-flight table
+	for (const FSoftObjectPath& DataAssetPath : BatchPaths)
+	{
+		CompleteInFlightADAM(DataAssetPath, BatchHandle);
+	}
+
+	// The batch stays in memory until the last of its entries is released
+	ReleaseStreamableHandleADAM(BatchHandle);
+}
+
+void UAsyncDataAssetManagerSubsystem::OnInFlightLoaded(FSoftObjectPath AssetPath)
+{
+	CompleteInFlightADAM(AssetPath);
+}
+
+void UAsyncDataAssetManagerSubsystem::CompleteInFlightADAM(const FSoftObjectPath& AssetPath, const TSharedPtr<FStreamableHandle>& BatchHandle)
+{
+	FInFlightADAM InFlight;
+
+	if (!InFlightADAM.RemoveAndCopyValue(AssetPath, InFlight))
+		return;
 
-		// Inform the FOnAllLoadedADAM subsystem delegate that the loading is complete
-		if (QueueCounterADAM[Tag] == 0)
+	IsQueueChanged = true;
+
+	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+	TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset(AssetPath);
+
+	int32 TargetIndex = DataADAM.FindSlot(AssetPath);
+
+	if (TargetIndex != INDEX_NONE)
+	{
+		// The entry takes over the descriptor of the request. Data Assets of a batch share the descriptor of the batch.
+		if (InFlight.StreamableHandle.IsValid())
 		{
-			OnAllLoadedADAM.Broadcast(Tag);
+			DataADAM.GetStreamableHandle(TargetIndex) = MoveTemp(InFlight.StreamableHandle);
+		}
+		else if (int32* SharedEntries = BatchHandle.IsValid() ? SharedHandlesADAM.Find(BatchHandle.Get()) : nullptr)
+		{
+			DataADAM.GetStreamableHandle(TargetIndex) = BatchHandle;
+			++(*SharedEntries);
+		}
+		else
+		{
+			// The batch completed before its request returned, the asset is already in memory, so no new IO is issued
+			DataADAM.GetStreamableHandle(TargetIndex) = StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate(), DataADAM.GetPriority(TargetIndex));
+		}
+	}
+	else if (InFlight.StreamableHandle.IsValid())
+	{
+		InFlight.StreamableHandle->ReleaseHandle();
+	}
 
-			if (EnableLog)
-			{
-				UE_LOG(LogTemp, Display, TEXT("ADAM (On All Loaded): All Data Assets has been loaded."), *PrimaryDataAsset.GetAssetName());
-			}
+	// Each owner receives its own notification
+	for (const FInFlightRequesterADAM& Requester : InFlight.Requesters)
+	{
+		TraceDataAssetLoadedADAM(AssetPath, Requester.Tag, Requester.RecursiveDepthLoading, Requester.RequestCycles);
+
+		OnStreamableLoaded(PrimaryDataAsset, Requester.Tag, Requester.RecursiveDepthLoading, Requester.Priority, Requester.NotifyAfterFullLoaded, Requester.RequestId, Requester.BatchId, Requester.IsNestedRequested);
+	}
+}
+
+void UAsyncDataAssetManagerSubsystem::ReleaseStreamableHandleADAM(const TSharedPtr<FStreamableHandle>& StreamableHandle)
+{
+	if (!StreamableHandle.IsValid())
+		return;
+
+	if (int32* SharedEntries = SharedHandlesADAM.Find(StreamableHandle.Get()))
+	{
+		if (--(*SharedEntries) > 0)
+			return;
 
-			QueueCounterADAM.Remove(Tag);
+		SharedHandlesADAM.Remove(StreamableHandle.Get());
+	}
+
+	StreamableHandle->ReleaseHandle();
+}
+
+UObject* UAsyncDataAssetManagerSubsystem::GetStreamableAssetADAM(const TSharedPtr<FStreamableHandle>& StreamableHandle, const FSoftObjectPath& AssetPath) const
+{
+	if (!StreamableHandle.IsValid())
+		return nullptr;
+
+	if (!SharedHandlesADAM.Contains(StreamableHandle.Get()))
+		return StreamableHandle->GetLoadedAsset();
+
+	return StreamableHandle->HasLoadCompleted() ? AssetPath.ResolveObject() : nullptr;
+}
+
+void UAsyncDataAssetManagerSubsystem::TryCompleteLoadBatchADAM(int32 BatchId)
+{
+	FLoadBatchADAM* LoadBatch = LoadBatchesADAM.Find(BatchId);
+
+	if (!LoadBatch || !LoadBatch->IsComplete())
+		return;
+
+	FName Tag = LoadBatch->Tag;
+	bool bNotifyAfterFullLoaded = LoadBatch->NotifyAfterFullLoaded;
+	bool bHasData = LoadBatch->NumCompleted > 0;
+
+	LoadBatchesADAM.Remove(BatchId);
+
+	// Listeners are not called in the middle of an unload
+	if (UnloadDepthADAM > 0)
+	{
+		DeferredNotificationsADAM.Add([this, BatchId, Tag, bNotifyAfterFullLoaded, bHasData]()
+		{
+			NotifyLoadBatchADAM(BatchId, Tag, bNotifyAfterFullLoaded, bHasData);
+		});
+
+		return;
+	}
+
+	NotifyLoadBatchADAM(BatchId, Tag, bNotifyAfterFullLoaded, bHasData);
+}
+
+void UAsyncDataAssetManagerSubsystem::NotifyLoadBatchADAM(int32 BatchId, FName Tag, bool NotifyAfterFullLoaded, bool HasData)
+{
+	CompletePreloadBatchADAM(BatchId);
+
+	// An array load without data to wait for is not reported
+	if (!HasData)
+		return;
+
+	// Inform the FOnAllLoadedADAM subsystem delegate that the loading is complete
+	if (NotifyAfterFullLoaded)
+	{
+		OnAllLoadedADAM.Broadcast(Tag);
+
+		if (EnableLog)
+		{
+			UE_LOG(LogTemp, Display, TEXT("ADAM (On All Loaded): All Data Assets has been loaded."));
 		}
 	}
+
+	// Inform the FOnBatchLoadedADAM subsystem delegate about the completion of this array load only
+	OnBatchLoadedADAM.Broadcast(BatchId, Tag);
+}
+
+void UAsyncDataAssetManagerSubsystem::BeginUnloadADAM()
+{
+	UnloadDepthADAM++;
+}
+
+void UAsyncDataAssetManagerSubsystem::EndUnloadADAM()
+{
+	if (--UnloadDepthADAM > 0)
+		return;
+
+	// Listeners may start new loads and unloads, those defer their own notifications
+	TArray<TFunction<void()>> Notifications = MoveTemp(DeferredNotificationsADAM);
+
+	for (TFunction<void()>& Notification : Notifications)
+	{
+		Notification();
+	}
 }
 
 #pragma endregion CALL_DELEGATE
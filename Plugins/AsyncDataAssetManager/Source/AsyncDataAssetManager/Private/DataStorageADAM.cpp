@@ -0,0 +1,328 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "DataStorageADAM.h"
+
+FHandleADAM FDataStorageADAM::Add(const FSoftObjectPath& AssetPath, TSharedPtr<FStreamableHandle> StreamableHandle, FName Tag, int32 Priority)
+{
+	int32 PathId = InternPath(AssetPath);
+
+	// One entry per asset, a repeated addition only adds the owner
+	if (const int32* ExistingSlot = PathIndex.Find(PathId))
+	{
+		AddOwner(*ExistingSlot, Tag);
+
+		return GetHandle(*ExistingSlot);
+	}
+
+	int32 Slot;
+
+	// Reuse a free slot without moving other entries
+	if (FreeSlots.Num() != 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		PathIds[Slot] = PathId;
+		StreamableHandles[Slot] = MoveTemp(StreamableHandle);
+		Owners[Slot].Add(Tag);
+		Priorities[Slot] = Priority;
+		ResidentSizes[Slot] = INDEX_NONE;
+		LastAccessTimes[Slot] = FPlatformTime::Seconds();
+		Classes[Slot] = nullptr;
+		LoadedAssets[Slot] = nullptr;
+		AliveSlots[Slot] = true;
+	}
+	else
+	{
+		Slot = PathIds.Add(PathId);
+		StreamableHandles.Add(MoveTemp(StreamableHandle));
+		Owners.AddDefaulted_GetRef().Add(Tag);
+		Priorities.Add(Priority);
+		ResidentSizes.Add(INDEX_NONE);
+		LastAccessTimes.Add(FPlatformTime::Seconds());
+		Classes.Add(nullptr);
+		LoadedAssets.Add(nullptr);
+		Generations.Add(0);
+		AliveSlots.Add(true);
+	}
+
+	NumEntries++;
+
+	PathIndex.Add(PathId, Slot);
+	TagIndex.FindOrAdd(Tag).Add(Slot);
+	MarkTagChanged(Tag);
+
+	return GetHandle(Slot);
+}
+
+void FDataStorageADAM::RemoveAt(int32 Slot)
+{
+	if (!IsValidIndex(Slot))
+		return;
+
+	PathIndex.Remove(PathIds[Slot]);
+	ReleasePathId(PathIds[Slot]);
+
+	while (!Owners[Slot].IsEmpty())
+	{
+		RemoveOwner(Slot, Owners[Slot].Last());
+	}
+
+	SetResidentSize(Slot, INDEX_NONE);
+	SetLoadedAsset(Slot, nullptr);
+	StreamableHandles[Slot].Reset();
+	AliveSlots[Slot] = false;
+	Generation++;
+
+	// Invalidate all handles issued for this slot
+	Generations[Slot]++;
+
+	FreeSlots.Add(Slot);
+	NumEntries--;
+}
+
+bool FDataStorageADAM::AddOwner(int32 Slot, FName Tag)
+{
+	if (!IsValidIndex(Slot) || Owners[Slot].Contains(Tag))
+		return false;
+
+	Owners[Slot].Add(Tag);
+	TagIndex.FindOrAdd(Tag).Add(Slot);
+	MarkTagChanged(Tag);
+
+	if (Classes[Slot])
+	{
+		InvalidateClassQueries(Classes[Slot], Tag, false);
+	}
+
+	return true;
+}
+
+bool FDataStorageADAM::RemoveOwner(int32 Slot, FName Tag)
+{
+	if (!IsValidIndex(Slot) || Owners[Slot].Remove(Tag) == 0)
+		return false;
+
+	if (TSet<int32>* TagBucket = TagIndex.Find(Tag))
+	{
+		TagBucket->Remove(Slot);
+
+		// Empty buckets are not stored, so the tag collection only contains tags in use
+		if (TagBucket->IsEmpty())
+		{
+			TagIndex.Remove(Tag);
+		}
+	}
+
+	MarkTagChanged(Tag);
+
+	if (Classes[Slot])
+	{
+		InvalidateClassQueries(Classes[Slot], Tag, false);
+	}
+
+	return true;
+}
+
+void FDataStorageADAM::SetResidentSize(int32 Slot, int64 ResidentSize)
+{
+	// Unmeasured entries are not included in the total
+	if (ResidentSizes[Slot] != INDEX_NONE)
+	{
+		TotalResidentSize -= ResidentSizes[Slot];
+	}
+
+	ResidentSizes[Slot] = ResidentSize;
+
+	if (ResidentSize != INDEX_NONE)
+	{
+		TotalResidentSize += ResidentSize;
+	}
+}
+
+void FDataStorageADAM::SetLoadedAsset(int32 Slot, UObject* LoadedAsset)
+{
+	if (LoadedAssets[Slot] == LoadedAsset)
+		return;
+
+	LoadedAssets[Slot] = LoadedAsset;
+
+	for (FName Owner : Owners[Slot])
+	{
+		MarkTagChanged(Owner);
+	}
+
+	Generation++;
+
+	const UClass* PreviousClass = Classes[Slot];
+	const UClass* Class = LoadedAsset ? LoadedAsset->GetClass() : nullptr;
+
+	if (PreviousClass == Class)
+		return;
+
+	if (PreviousClass)
+	{
+		TSet<int32>& ClassBucket = ClassIndex.FindChecked(PreviousClass);
+		ClassBucket.Remove(Slot);
+
+		if (ClassBucket.IsEmpty())
+		{
+			ClassIndex.Remove(PreviousClass);
+		}
+
+		InvalidateClassQueries(PreviousClass, NAME_None, true);
+	}
+
+	Classes[Slot] = Class;
+
+	if (Class)
+	{
+		ClassIndex.FindOrAdd(Class).Add(Slot);
+		InvalidateClassQueries(Class, NAME_None, true);
+	}
+}
+
+const TArray<int32>& FDataStorageADAM::FindClassSlots(const UClass* Class, FName Tag, bool bIgnoreTag) const
+{
+	FClassQuery Query;
+	Query.Class = Class;
+	Query.Tag = bIgnoreTag ? NAME_None : Tag;
+	Query.bIgnoreTag = bIgnoreTag;
+
+	if (const TArray<int32>* CachedSlots = ClassQueryCache.Find(Query))
+		return *CachedSlots;
+
+	TArray<int32> Slots;
+
+	// The number of distinct classes is small compared to the number of entries
+	for (const TPair<const UClass*, TSet<int32>>& ClassBucket : ClassIndex)
+	{
+		if (!ClassBucket.Key->IsChildOf(Class))
+			continue;
+
+		for (int32 Slot : ClassBucket.Value)
+		{
+			if (bIgnoreTag || HasOwner(Slot, Tag))
+			{
+				Slots.Add(Slot);
+			}
+		}
+	}
+
+	// Same order as the iteration over the storage
+	Slots.Sort();
+
+	return ClassQueryCache.Add(Query, MoveTemp(Slots));
+}
+
+void FDataStorageADAM::InvalidateClassQueries(const UClass* Class, FName Tag, bool bAllTags)
+{
+	for (TMap<FClassQuery, TArray<int32>>::TIterator It = ClassQueryCache.CreateIterator(); It; ++It)
+	{
+		const FClassQuery& Query = It.Key();
+
+		// Queries of the tags the entry does not change are still valid
+		if (!bAllTags && !Query.bIgnoreTag && Query.Tag != Tag)
+			continue;
+
+		// The results of the collected classes are never requested again
+		if (!Query.Class.IsValid() || Class->IsChildOf(Query.Class.Get()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FDataStorageADAM::Empty()
+{
+	PathIds.Empty();
+	StreamableHandles.Empty();
+	Owners.Empty();
+	Priorities.Empty();
+	ResidentSizes.Empty();
+	LastAccessTimes.Empty();
+	Classes.Empty();
+	LoadedAssets.Empty();
+	Generations.Empty();
+	AliveSlots.Empty();
+	FreeSlots.Empty();
+	NumEntries = 0;
+	TotalResidentSize = 0;
+
+	// Readers compare generations, so the counters continue after the storage is emptied
+	Generation++;
+
+	for (TPair<FName, int32>& TagGeneration : TagGenerations)
+	{
+		TagGeneration.Value = Generation;
+	}
+
+	InternedPaths.Empty();
+	PathToId.Empty();
+	FreePathIds.Empty();
+
+	PathIndex.Empty();
+	TagIndex.Empty();
+	ClassIndex.Empty();
+	ClassQueryCache.Empty();
+}
+
+FHandleADAM FDataStorageADAM::GetHandle(int32 Slot) const
+{
+	FHandleADAM Handle;
+
+	if (IsValidIndex(Slot))
+	{
+		Handle.Index = Slot;
+		Handle.Generation = Generations[Slot];
+	}
+
+	return Handle;
+}
+
+int32 FDataStorageADAM::FindSlot(const FSoftObjectPath& AssetPath) const
+{
+	int32 PathId = FindPathId(AssetPath);
+
+	if (PathId == INDEX_NONE)
+		return INDEX_NONE;
+
+	const int32* Slot = PathIndex.Find(PathId);
+
+	return Slot ? *Slot : INDEX_NONE;
+}
+
+int32 FDataStorageADAM::FindPathId(const FSoftObjectPath& AssetPath) const
+{
+	const int32* PathId = PathToId.Find(AssetPath);
+
+	return PathId ? *PathId : INDEX_NONE;
+}
+
+int32 FDataStorageADAM::InternPath(const FSoftObjectPath& AssetPath)
+{
+	if (const int32* PathId = PathToId.Find(AssetPath))
+		return *PathId;
+
+	int32 NewPathId;
+
+	// Reuse the ID of a removed entry, so the table is bounded by the peak number of entries
+	if (FreePathIds.Num() != 0)
+	{
+		NewPathId = FreePathIds.Pop(EAllowShrinking::No);
+		InternedPaths[NewPathId] = AssetPath;
+	}
+	else
+	{
+		NewPathId = InternedPaths.Add(AssetPath);
+	}
+
+	PathToId.Add(AssetPath, NewPathId);
+
+	return NewPathId;
+}
+
+void FDataStorageADAM::ReleasePathId(int32 PathId)
+{
+	PathToId.Remove(InternedPaths[PathId]);
+	InternedPaths[PathId].Reset();
+	FreePathIds.Add(PathId);
+}
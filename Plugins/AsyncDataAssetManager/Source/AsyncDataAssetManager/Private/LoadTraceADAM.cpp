@@ -0,0 +1,190 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "LoadTraceADAM.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace LoadTraceADAM
+{
+	// "ADLT" in little endian
+	constexpr uint32 Magic = 0x544C4441;
+
+	constexpr int32 Version = 1;
+}
+
+void FLoadTraceADAM::Start()
+{
+	Empty();
+
+	StartTime = FPlatformTime::Seconds();
+}
+
+FLoadTraceEventADAM& FLoadTraceADAM::AddEvent(ELoadTraceEventADAM Type, const TArray<FSoftObjectPath>& AssetPaths, const TArray<FName>& EventTags)
+{
+	FLoadTraceEventADAM& Event = Events.AddDefaulted_GetRef();
+	Event.Type = Type;
+	Event.Time = FPlatformTime::Seconds() - StartTime;
+
+	Event.PathIds.Reserve(AssetPaths.Num());
+
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		Event.PathIds.Add(InternPath(AssetPath));
+	}
+
+	Event.TagIds.Reserve(EventTags.Num());
+
+	for (FName Tag : EventTags)
+	{
+		Event.TagIds.Add(InternTag(Tag));
+	}
+
+	return Event;
+}
+
+void FLoadTraceADAM::Empty()
+{
+	Paths.Empty();
+	PathToId.Empty();
+	Tags.Empty();
+	TagToId.Empty();
+	Events.Empty();
+}
+
+bool FLoadTraceADAM::LoadFromFile(const FString& FileName)
+{
+	TArray<uint8> FileData;
+
+	if (!FFileHelper::LoadFileToArray(FileData, *FileName, FILEREAD_Silent))
+		return false;
+
+	FMemoryReader Reader(FileData);
+	Reader << *this;
+
+	if (Reader.IsError())
+	{
+		Empty();
+
+		return false;
+	}
+
+	return true;
+}
+
+bool FLoadTraceADAM::SaveToFile(const FString& FileName) const
+{
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+	Writer << const_cast<FLoadTraceADAM&>(*this);
+
+	return FFileHelper::SaveArrayToFile(FileData, *FileName);
+}
+
+int32 FLoadTraceADAM::InternPath(const FSoftObjectPath& AssetPath)
+{
+	if (const int32* PathId = PathToId.Find(AssetPath))
+		return *PathId;
+
+	int32 NewPathId = Paths.Add(AssetPath);
+	PathToId.Add(AssetPath, NewPathId);
+
+	return NewPathId;
+}
+
+int32 FLoadTraceADAM::InternTag(FName Tag)
+{
+	if (const int32* TagId = TagToId.Find(Tag))
+		return *TagId;
+
+	int32 NewTagId = Tags.Add(Tag);
+	TagToId.Add(Tag, NewTagId);
+
+	return NewTagId;
+}
+
+FArchive& operator<<(FArchive& Ar, FLoadTraceADAM& Trace)
+{
+	uint32 Magic = LoadTraceADAM::Magic;
+	int32 Version = LoadTraceADAM::Version;
+
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != LoadTraceADAM::Magic || Version != LoadTraceADAM::Version))
+	{
+		Ar.SetError();
+
+		return Ar;
+	}
+
+	// Paths and tags are stored as strings, so the file does not depend on the name table of the archive
+	TArray<FString> PathStrings;
+	TArray<FString> TagStrings;
+
+	if (!Ar.IsLoading())
+	{
+		for (const FSoftObjectPath& AssetPath : Trace.Paths)
+		{
+			PathStrings.Add(AssetPath.ToString());
+		}
+
+		for (FName Tag : Trace.Tags)
+		{
+			TagStrings.Add(Tag.ToString());
+		}
+	}
+
+	Ar << PathStrings << TagStrings << Trace.Events;
+
+	if (Ar.IsLoading() && !Ar.IsError())
+	{
+		Trace.Paths.Reset(PathStrings.Num());
+		Trace.PathToId.Reset();
+		Trace.Tags.Reset(TagStrings.Num());
+		Trace.TagToId.Reset();
+
+		for (const FString& PathString : PathStrings)
+		{
+			FSoftObjectPath AssetPath(PathString);
+			Trace.PathToId.Add(AssetPath, Trace.Paths.Add(AssetPath));
+		}
+
+		for (const FString& TagString : TagStrings)
+		{
+			FName Tag(*TagString);
+			Trace.TagToId.Add(Tag, Trace.Tags.Add(Tag));
+		}
+
+		// A damaged file must not produce IDs outside of the tables
+		for (const FLoadTraceEventADAM& Event : Trace.Events)
+		{
+			bool bIsValidEvent = Event.Type <= ELoadTraceEventADAM::UnloadAllTags;
+
+			// Calls with a single Data Asset
+			if (Event.Type == ELoadTraceEventADAM::Load || Event.Type == ELoadTraceEventADAM::FastLoad || Event.Type == ELoadTraceEventADAM::Unload)
+			{
+				bIsValidEvent &= Event.PathIds.Num() == 1;
+			}
+
+			for (int32 PathId : Event.PathIds)
+			{
+				bIsValidEvent &= Trace.Paths.IsValidIndex(PathId);
+			}
+
+			for (int32 TagId : Event.TagIds)
+			{
+				bIsValidEvent &= Trace.Tags.IsValidIndex(TagId);
+			}
+
+			if (!bIsValidEvent)
+			{
+				Ar.SetError();
+
+				break;
+			}
+		}
+	}
+
+	return Ar;
+}
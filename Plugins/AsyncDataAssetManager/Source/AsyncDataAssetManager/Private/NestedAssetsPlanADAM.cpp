@@ -0,0 +1,274 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "NestedAssetsPlanADAM.h"
+
+#include "Engine/DataAsset.h"
+#include "UObject/UnrealType.h"
+#include "UObject/PropertyOptional.h"
+
+FRWLock FNestedAssetsPlanADAM::CacheLock;
+TMap<TObjectKey<UStruct>, FNestedAssetsPlanADAM::FPlanPtr> FNestedAssetsPlanADAM::Cache;
+
+TSharedRef<const FNestedAssetsPlanADAM, ESPMode::ThreadSafe> FNestedAssetsPlanADAM::Get(const UStruct* Struct)
+{
+	check(Struct);
+
+	{
+		FReadScopeLock ReadLock(CacheLock);
+
+		if (const FPlanPtr* CachedPlan = Cache.Find(TObjectKey<UStruct>(Struct)))
+			return CachedPlan->ToSharedRef();
+	}
+
+	FBuildContext Context;
+	FPlanPtr Plan = BuildStructPlan(Struct, Context);
+
+	{
+		FWriteScopeLock WriteLock(CacheLock);
+
+		// Another thread could have built the same types in the meantime, the first published plan is kept
+		for (const TPair<const UStruct*, FPlanPtr>& BuiltPlan : Context.Plans)
+		{
+			TObjectKey<UStruct> StructKey(BuiltPlan.Key);
+
+			if (IsCacheable(BuiltPlan.Key) && !Cache.Contains(StructKey))
+			{
+				Cache.Add(StructKey, BuiltPlan.Value);
+			}
+		}
+	}
+
+	return Plan.ToSharedRef();
+}
+
+void FNestedAssetsPlanADAM::ResetCache()
+{
+	FWriteScopeLock WriteLock(CacheLock);
+
+	Cache.Empty();
+}
+
+bool FNestedAssetsPlanADAM::IsCacheable(const UStruct* Struct)
+{
+#if WITH_EDITOR
+	// Blueprint classes and user defined structs are recompiled in place, the property pointers of their plans would dangle
+	if (const UClass* Class = Cast<UClass>(Struct))
+		return Class->HasAnyClassFlags(CLASS_Native);
+
+	if (const UScriptStruct* ScriptStruct = Cast<UScriptStruct>(Struct))
+		return (ScriptStruct->StructFlags & STRUCT_Native) != 0;
+
+	return false;
+#else
+	return true;
+#endif
+}
+
+FNestedAssetsPlanADAM::FPlanPtr FNestedAssetsPlanADAM::BuildStructPlan(const UStruct* Struct, FBuildContext& Context)
+{
+	if (const FPlanPtr* BuiltPlan = Context.Plans.Find(Struct))
+		return *BuiltPlan;
+
+	{
+		FReadScopeLock ReadLock(CacheLock);
+
+		if (const FPlanPtr* CachedPlan = Cache.Find(TObjectKey<UStruct>(Struct)))
+			return *CachedPlan;
+	}
+
+	FPlanPtr Plan = MakeShared<FNestedAssetsPlanADAM, ESPMode::ThreadSafe>();
+
+	// Registered before the properties are visited, so self-referencing types reuse the plan
+	Context.Plans.Add(Struct, Plan);
+	Context.InProgress.Add(Struct);
+
+	for (TFieldIterator<FProperty> PropIterator(Struct); PropIterator; ++PropIterator)
+	{
+		AppendPropertySteps(*PropIterator, PropIterator->GetOffset_ForInternal(), *Plan, Context);
+	}
+
+	Context.InProgress.Remove(Struct);
+
+	return Plan;
+}
+
+FNestedAssetsPlanADAM::FPlanPtr FNestedAssetsPlanADAM::BuildElementPlan(const FProperty* Property, FBuildContext& Context)
+{
+	if (!Property)
+		return nullptr;
+
+	FPlanPtr ElementPlan = MakeShared<FNestedAssetsPlanADAM, ESPMode::ThreadSafe>();
+
+	// Script helpers return the address of the element itself, so the element is planned at offset 0
+	AppendPropertySteps(Property, 0, *ElementPlan, Context);
+
+	return ElementPlan->IsEmpty() ? nullptr : ElementPlan;
+}
+
+void FNestedAssetsPlanADAM::AppendPropertySteps(const FProperty* Property, int32 Offset, FNestedAssetsPlanADAM& Plan, FBuildContext& Context)
+{
+	FStep Step;
+	Step.Offset = Offset;
+	Step.ArrayDim = Property->GetArrayDim();
+	Step.ElementSize = Property->GetElementSize();
+	Step.Property = Property;
+
+	// Soft object properties (TSoftObjectPtr<UPrimaryDataAsset>)
+	if (const FSoftObjectProperty* SoftObjectProperty = CastField<FSoftObjectProperty>(Property))
+	{
+		if (!SoftObjectProperty->PropertyClass || !SoftObjectProperty->PropertyClass->IsChildOf(UPrimaryDataAsset::StaticClass()))
+			return;
+
+		Step.Type = EStepType::SoftObject;
+	}
+	// Struct properties. A type that is still being built can reference itself and is kept.
+	else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		Step.ElementPlan = BuildStructPlan(StructProperty->Struct, Context);
+
+		if (Step.ElementPlan->IsEmpty() && !Context.InProgress.Contains(StructProperty->Struct))
+			return;
+
+		Step.Type = EStepType::Struct;
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		Step.ElementPlan = BuildElementPlan(ArrayProperty->Inner, Context);
+
+		if (!Step.ElementPlan)
+			return;
+
+		Step.Type = EStepType::Array;
+	}
+	else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		Step.ElementPlan = BuildElementPlan(SetProperty->ElementProp, Context);
+
+		if (!Step.ElementPlan)
+			return;
+
+		Step.Type = EStepType::Set;
+	}
+	else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		Step.KeyPlan = BuildElementPlan(MapProperty->KeyProp, Context);
+		Step.ElementPlan = BuildElementPlan(MapProperty->ValueProp, Context);
+
+		if (!Step.KeyPlan && !Step.ElementPlan)
+			return;
+
+		Step.Type = EStepType::Map;
+	}
+	else if (const FOptionalProperty* OptionalProperty = CastField<FOptionalProperty>(Property))
+	{
+		Step.ElementPlan = BuildElementPlan(OptionalProperty->GetValueProperty(), Context);
+
+		if (!Step.ElementPlan)
+			return;
+
+		Step.Type = EStepType::Optional;
+	}
+	else
+	{
+		return;
+	}
+
+	Plan.Steps.Add(MoveTemp(Step));
+}
+
+void FNestedAssetsPlanADAM::Scan(const void* Container, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& OutNestedAssets, TSet<FSoftObjectPath>& UniqueAssetPaths) const
+{
+	for (const FStep& Step : Steps)
+	{
+		for (int32 ArrayIndex = 0; ArrayIndex < Step.ArrayDim; ++ArrayIndex)
+		{
+			const uint8* ValuePtr = static_cast<const uint8*>(Container) + Step.Offset + ArrayIndex * Step.ElementSize;
+
+			switch (Step.Type)
+			{
+			case EStepType::SoftObject:
+			{
+				const FSoftObjectPath& AssetPath = reinterpret_cast<const FSoftObjectPtr*>(ValuePtr)->GetUniqueID();
+
+				if (AssetPath.IsNull())
+					break;
+
+				// Deduplication by path hash
+				bool bIsAlreadyFound = false;
+				UniqueAssetPaths.Add(AssetPath, &bIsAlreadyFound);
+
+				if (!bIsAlreadyFound)
+				{
+					OutNestedAssets.Add(TSoftObjectPtr<UPrimaryDataAsset>(AssetPath));
+				}
+
+				break;
+			}
+			case EStepType::Struct:
+			{
+				Step.ElementPlan->Scan(ValuePtr, OutNestedAssets, UniqueAssetPaths);
+
+				break;
+			}
+			case EStepType::Array:
+			{
+				FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(Step.Property), ValuePtr);
+
+				for (int32 i = 0; i < ArrayHelper.Num(); ++i)
+				{
+					Step.ElementPlan->Scan(ArrayHelper.GetRawPtr(i), OutNestedAssets, UniqueAssetPaths);
+				}
+
+				break;
+			}
+			case EStepType::Set:
+			{
+				FScriptSetHelper SetHelper(static_cast<const FSetProperty*>(Step.Property), ValuePtr);
+
+				for (int32 i = 0; i < SetHelper.GetMaxIndex(); ++i)
+				{
+					if (SetHelper.IsValidIndex(i))
+					{
+						Step.ElementPlan->Scan(SetHelper.GetElementPtr(i), OutNestedAssets, UniqueAssetPaths);
+					}
+				}
+
+				break;
+			}
+			case EStepType::Map:
+			{
+				FScriptMapHelper MapHelper(static_cast<const FMapProperty*>(Step.Property), ValuePtr);
+
+				for (int32 i = 0; i < MapHelper.GetMaxIndex(); ++i)
+				{
+					if (!MapHelper.IsValidIndex(i))
+						continue;
+
+					if (Step.KeyPlan)
+					{
+						Step.KeyPlan->Scan(MapHelper.GetKeyPtr(i), OutNestedAssets, UniqueAssetPaths);
+					}
+
+					if (Step.ElementPlan)
+					{
+						Step.ElementPlan->Scan(MapHelper.GetValuePtr(i), OutNestedAssets, UniqueAssetPaths);
+					}
+				}
+
+				break;
+			}
+			case EStepType::Optional:
+			{
+				const FOptionalProperty* OptionalProperty = static_cast<const FOptionalProperty*>(Step.Property);
+
+				if (OptionalProperty->IsSet(ValuePtr))
+				{
+					Step.ElementPlan->Scan(OptionalProperty->GetValuePointerForRead(ValuePtr), OutNestedAssets, UniqueAssetPaths);
+				}
+
+				break;
+			}
+			}
+		}
+	}
+}
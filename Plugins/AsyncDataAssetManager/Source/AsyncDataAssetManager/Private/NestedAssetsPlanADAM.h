@@ -0,0 +1,92 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UPrimaryDataAsset;
+
+/**
+ * Precompiled soft-reference plan of a UStruct or UClass.
+ *
+ * The plan contains only the property offsets and container hops (arrays, sets, maps, optionals, structs)
+ * that can hold a soft pointer to a UPrimaryDataAsset, so scanning an instance skips all unrelated properties.
+ * Plans are built once per type on first use and cached for the lifetime of the process. In the editor the plans
+ * of Blueprint types and user defined structs are not cached, since recompiling them changes the layout in place,
+ * and the cache is reset whenever types are reinstanced or reloaded.
+ */
+class FNestedAssetsPlanADAM
+{
+public:
+	// Returns the plan of the type. Safe to call from any thread.
+	static TSharedRef<const FNestedAssetsPlanADAM, ESPMode::ThreadSafe> Get(const UStruct* Struct);
+
+	/**
+	 * Collects soft pointers to Primary Data Assets from the memory of an instance of the planned type.
+	 *
+	 * @param Container Pointer to the memory of the struct or object instance being inspected.
+	 * @param OutNestedAssets Array to collect discovered nested PrimaryDataAssets.
+	 * @param UniqueAssetPaths Set of asset paths used to prevent duplicates when collecting assets.
+	 */
+	void Scan(const void* Container, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& OutNestedAssets, TSet<FSoftObjectPath>& UniqueAssetPaths) const;
+
+	bool IsEmpty() const { return Steps.IsEmpty(); }
+
+	// Drops all cached plans. Plans still held by running scans stay valid until they are released.
+	static void ResetCache();
+
+private:
+	using FPlanPtr = TSharedPtr<FNestedAssetsPlanADAM, ESPMode::ThreadSafe>;
+
+	enum class EStepType : uint8
+	{
+		SoftObject,
+		Struct,
+		Array,
+		Set,
+		Map,
+		Optional
+	};
+
+	struct FStep
+	{
+		EStepType Type = EStepType::SoftObject;
+
+		// Offset of the value in the container and the layout of static arrays
+		int32 Offset = 0;
+		int32 ArrayDim = 1;
+		int32 ElementSize = 0;
+
+		// Container property, used by the script helpers
+		const FProperty* Property = nullptr;
+
+		// Plan of the struct, of the container element or of the map value
+		FPlanPtr ElementPlan;
+
+		// Plan of the map key
+		FPlanPtr KeyPlan;
+	};
+
+	// Plans created during one build. Published to the cache together once the build is complete.
+	struct FBuildContext
+	{
+		TMap<const UStruct*, FPlanPtr> Plans;
+		TSet<const UStruct*> InProgress;
+	};
+
+	static FPlanPtr BuildStructPlan(const UStruct* Struct, FBuildContext& Context);
+
+	// Returns false if the plan of the type can become invalid while the process is running.
+	static bool IsCacheable(const UStruct* Struct);
+
+	// Returns the plan of a single container element, or nullptr if the element can't hold a reference.
+	static FPlanPtr BuildElementPlan(const FProperty* Property, FBuildContext& Context);
+
+	static void AppendPropertySteps(const FProperty* Property, int32 Offset, FNestedAssetsPlanADAM& Plan, FBuildContext& Context);
+
+	TArray<FStep> Steps;
+
+	static FRWLock CacheLock;
+	static TMap<TObjectKey<UStruct>, FPlanPtr> Cache;
+};
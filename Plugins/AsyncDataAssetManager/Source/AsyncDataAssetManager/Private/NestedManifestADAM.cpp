@@ -0,0 +1,237 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "NestedManifestADAM.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace NestedManifestADAM
+{
+	// "ADAM" in little endian
+	constexpr uint32 Magic = 0x4D414441;
+
+	// 2: saved hashes of the packages
+	constexpr int32 Version = 2;
+}
+
+void FNestedManifestADAM::SetClosure(const FSoftObjectPath& AssetPath, const TArray<TPair<FSoftObjectPath, int32>>& Closure)
+{
+	TArray<FEntry>& Entries = Closures.FindOrAdd(InternPath(AssetPath));
+	Entries.Reset(Closure.Num());
+
+	for (const TPair<FSoftObjectPath, int32>& NestedAsset : Closure)
+	{
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.PathId = InternPath(NestedAsset.Key);
+		Entry.Depth = NestedAsset.Value;
+	}
+
+	// Ordered by depth, so a depth limited request stops at the first deeper entry
+	Entries.StableSort([](const FEntry& A, const FEntry& B) { return A.Depth < B.Depth; });
+}
+
+bool FNestedManifestADAM::GetClosure(const FSoftObjectPath& AssetPath, int32 RecursiveDepthLoading, TArray<FSoftObjectPath>& OutClosure) const
+{
+	const int32* PathId = PathToId.Find(AssetPath);
+
+	if (!PathId)
+		return false;
+
+	const TArray<FEntry>* Entries = Closures.Find(*PathId);
+
+	if (!Entries)
+		return false;
+
+	OutClosure.Reserve(OutClosure.Num() + Entries->Num());
+
+	for (const FEntry& Entry : *Entries)
+	{
+		if (RecursiveDepthLoading != -1 && Entry.Depth > RecursiveDepthLoading)
+			break;
+
+		OutClosure.Add(Paths[Entry.PathId]);
+	}
+
+	return true;
+}
+
+bool FNestedManifestADAM::Contains(const FSoftObjectPath& AssetPath) const
+{
+	const int32* PathId = PathToId.Find(AssetPath);
+
+	return PathId && Closures.Contains(*PathId);
+}
+
+void FNestedManifestADAM::SetSavedHash(const FSoftObjectPath& AssetPath, const FIoHash& SavedHash)
+{
+	SavedHashes[InternPath(AssetPath)] = SavedHash;
+}
+
+int32 FNestedManifestADAM::RemoveStaleClosures(TFunctionRef<FIoHash(const FSoftObjectPath&)> GetSavedHash)
+{
+	TBitArray<> StalePathIds(false, Paths.Num());
+	bool bHasStalePaths = false;
+
+	for (int32 PathId = 0; PathId < Paths.Num(); ++PathId)
+	{
+		if (SavedHashes[PathId].IsZero())
+			continue;
+
+		FIoHash CurrentHash = GetSavedHash(Paths[PathId]);
+
+		if (!CurrentHash.IsZero() && CurrentHash != SavedHashes[PathId])
+		{
+			StalePathIds[PathId] = true;
+			bHasStalePaths = true;
+		}
+	}
+
+	if (!bHasStalePaths)
+		return 0;
+
+	// A closure is stale if its root or any of its nested Data Assets has changed
+	int32 NumRemoved = 0;
+
+	for (auto It = Closures.CreateIterator(); It; ++It)
+	{
+		bool bIsStale = StalePathIds[It.Key()];
+
+		for (int32 i = 0; i < It.Value().Num() && !bIsStale; ++i)
+		{
+			bIsStale = StalePathIds[It.Value()[i].PathId];
+		}
+
+		if (bIsStale)
+		{
+			It.RemoveCurrent();
+			NumRemoved++;
+		}
+	}
+
+	return NumRemoved;
+}
+
+void FNestedManifestADAM::Empty()
+{
+	Paths.Empty();
+	PathToId.Empty();
+	SavedHashes.Empty();
+	Closures.Empty();
+}
+
+bool FNestedManifestADAM::LoadFromFile(const FString& FileName)
+{
+	TArray<uint8> FileData;
+
+	if (!FFileHelper::LoadFileToArray(FileData, *FileName, FILEREAD_Silent))
+		return false;
+
+	FMemoryReader Reader(FileData);
+	Reader << *this;
+
+	if (Reader.IsError())
+	{
+		Empty();
+
+		return false;
+	}
+
+	return true;
+}
+
+bool FNestedManifestADAM::SaveToFile(const FString& FileName) const
+{
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+	Writer << const_cast<FNestedManifestADAM&>(*this);
+
+	return FFileHelper::SaveArrayToFile(FileData, *FileName);
+}
+
+int32 FNestedManifestADAM::InternPath(const FSoftObjectPath& AssetPath)
+{
+	if (const int32* PathId = PathToId.Find(AssetPath))
+		return *PathId;
+
+	int32 NewPathId = Paths.Add(AssetPath);
+	PathToId.Add(AssetPath, NewPathId);
+	SavedHashes.AddDefaulted();
+
+	return NewPathId;
+}
+
+FArchive& operator<<(FArchive& Ar, FNestedManifestADAM& Manifest)
+{
+	uint32 Magic = NestedManifestADAM::Magic;
+	int32 Version = NestedManifestADAM::Version;
+
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != NestedManifestADAM::Magic || Version != NestedManifestADAM::Version))
+	{
+		Ar.SetError();
+
+		return Ar;
+	}
+
+	// Paths are stored as strings, so the file does not depend on the name table of the archive
+	int32 NumPaths = Manifest.Paths.Num();
+	Ar << NumPaths;
+
+	if (Ar.IsLoading())
+	{
+		Manifest.Empty();
+		Manifest.Paths.Reserve(NumPaths);
+		Manifest.PathToId.Reserve(NumPaths);
+
+		for (int32 PathId = 0; PathId < NumPaths && !Ar.IsError(); ++PathId)
+		{
+			FString PathString;
+			Ar << PathString;
+
+			FSoftObjectPath AssetPath(PathString);
+			Manifest.Paths.Add(AssetPath);
+			Manifest.PathToId.Add(AssetPath, PathId);
+		}
+	}
+	else
+	{
+		for (const FSoftObjectPath& AssetPath : Manifest.Paths)
+		{
+			FString PathString = AssetPath.ToString();
+			Ar << PathString;
+		}
+	}
+
+	Ar << Manifest.SavedHashes;
+	Ar << Manifest.Closures;
+
+	if (Ar.IsLoading() && !Ar.IsError() && Manifest.SavedHashes.Num() != Manifest.Paths.Num())
+	{
+		Ar.SetError();
+	}
+
+	if (Ar.IsLoading() && !Ar.IsError())
+	{
+		// A damaged file must not produce path IDs outside of the path table
+		for (const TPair<int32, TArray<FNestedManifestADAM::FEntry>>& Closure : Manifest.Closures)
+		{
+			bool bIsValidClosure = Manifest.Paths.IsValidIndex(Closure.Key);
+
+			for (const FNestedManifestADAM::FEntry& Entry : Closure.Value)
+			{
+				bIsValidClosure &= Manifest.Paths.IsValidIndex(Entry.PathId);
+			}
+
+			if (!bIsValidClosure)
+			{
+				Ar.SetError();
+
+				break;
+			}
+		}
+	}
+
+	return Ar;
+}
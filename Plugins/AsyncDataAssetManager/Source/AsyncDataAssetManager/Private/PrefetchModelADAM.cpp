@@ -0,0 +1,247 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "PrefetchModelADAM.h"
+
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace PrefetchModelADAM
+{
+	// "ADPF" in little endian
+	constexpr uint32 Magic = 0x46504441;
+
+	constexpr int32 Version = 1;
+
+	// Observations of a tag are halved above this number, so the model follows changes of the game flow
+	constexpr int32 MaxObservations = 1024;
+}
+
+bool FPrefetchModelADAM::RecordLoad(FName Tag, const TArray<FSoftObjectPath>& AssetPaths, int32 MaxAssetsPerTag)
+{
+	if (Tag.IsNone())
+		return false;
+
+	bool bIsTransition = LastTag != Tag;
+
+	if (bIsTransition && !LastTag.IsNone())
+	{
+		TMap<FName, int32>& NextTags = Transitions.FindOrAdd(LastTag);
+		NextTags.FindOrAdd(Tag)++;
+
+		int32 NumObservations = 0;
+
+		for (const TPair<FName, int32>& NextTag : NextTags)
+		{
+			NumObservations += NextTag.Value;
+		}
+
+		if (NumObservations > PrefetchModelADAM::MaxObservations)
+		{
+			for (TPair<FName, int32>& NextTag : NextTags)
+			{
+				NextTag.Value /= 2;
+			}
+
+			NextTags = NextTags.FilterByPredicate([](const TPair<FName, int32>& NextTag) { return NextTag.Value > 0; });
+		}
+	}
+
+	LastTag = Tag;
+
+	// The new data assets go first, the older ones fill the rest of the list
+	TArray<FSoftObjectPath>& Assets = TagAssets.FindOrAdd(Tag);
+	TArray<FSoftObjectPath> RecentAssets;
+	TSet<FSoftObjectPath> UniquePaths;
+
+	RecentAssets.Reserve(MaxAssetsPerTag);
+
+	const TArray<FSoftObjectPath>* Sources[] = { &AssetPaths, &Assets };
+
+	for (const TArray<FSoftObjectPath>* Source : Sources)
+	{
+		for (const FSoftObjectPath& AssetPath : *Source)
+		{
+			if (RecentAssets.Num() >= MaxAssetsPerTag)
+				break;
+
+			bool bIsAlreadyAdded = false;
+			UniquePaths.Add(AssetPath, &bIsAlreadyAdded);
+
+			if (!bIsAlreadyAdded && !AssetPath.IsNull())
+			{
+				RecentAssets.Add(AssetPath);
+			}
+		}
+	}
+
+	Assets = MoveTemp(RecentAssets);
+
+	return bIsTransition;
+}
+
+FName FPrefetchModelADAM::PredictNext(FName Tag, float MinProbability) const
+{
+	const TMap<FName, int32>* NextTags = Transitions.Find(Tag);
+
+	if (!NextTags)
+		return NAME_None;
+
+	FName PredictedTag = NAME_None;
+	int32 MaxObservations = 0;
+	int32 NumObservations = 0;
+
+	for (const TPair<FName, int32>& NextTag : *NextTags)
+	{
+		NumObservations += NextTag.Value;
+
+		if (NextTag.Value > MaxObservations)
+		{
+			MaxObservations = NextTag.Value;
+			PredictedTag = NextTag.Key;
+		}
+	}
+
+	if (NumObservations == 0 || float(MaxObservations) / NumObservations < MinProbability)
+		return NAME_None;
+
+	return PredictedTag;
+}
+
+const TArray<FSoftObjectPath>* FPrefetchModelADAM::FindAssets(FName Tag) const
+{
+	return TagAssets.Find(Tag);
+}
+
+void FPrefetchModelADAM::Empty()
+{
+	LastTag = NAME_None;
+	Transitions.Empty();
+	TagAssets.Empty();
+}
+
+bool FPrefetchModelADAM::LoadFromFile(const FString& FileName)
+{
+	TArray<uint8> FileData;
+
+	if (!FFileHelper::LoadFileToArray(FileData, *FileName, FILEREAD_Silent))
+		return false;
+
+	FMemoryReader Reader(FileData);
+	Reader << *this;
+
+	if (Reader.IsError())
+	{
+		Empty();
+
+		return false;
+	}
+
+	return true;
+}
+
+bool FPrefetchModelADAM::SaveToFile(const FString& FileName) const
+{
+	TArray<uint8> FileData;
+	FMemoryWriter Writer(FileData);
+	Writer << const_cast<FPrefetchModelADAM&>(*this);
+
+	return FFileHelper::SaveArrayToFile(FileData, *FileName);
+}
+
+FArchive& operator<<(FArchive& Ar, FPrefetchModelADAM& Model)
+{
+	uint32 Magic = PrefetchModelADAM::Magic;
+	int32 Version = PrefetchModelADAM::Version;
+
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != PrefetchModelADAM::Magic || Version != PrefetchModelADAM::Version))
+	{
+		Ar.SetError();
+
+		return Ar;
+	}
+
+	// Tags and paths are stored as strings, so the file does not depend on the name table of the archive
+	if (Ar.IsLoading())
+	{
+		Model.Empty();
+
+		int32 NumTransitions = 0;
+		Ar << NumTransitions;
+
+		for (int32 i = 0; i < NumTransitions && !Ar.IsError(); i++)
+		{
+			FString TagString;
+			int32 NumNextTags = 0;
+			Ar << TagString << NumNextTags;
+
+			TMap<FName, int32>& NextTags = Model.Transitions.Add(FName(*TagString));
+
+			for (int32 j = 0; j < NumNextTags && !Ar.IsError(); j++)
+			{
+				FString NextTagString;
+				int32 NumObservations = 0;
+				Ar << NextTagString << NumObservations;
+
+				NextTags.Add(FName(*NextTagString), NumObservations);
+			}
+		}
+
+		int32 NumTags = 0;
+		Ar << NumTags;
+
+		for (int32 i = 0; i < NumTags && !Ar.IsError(); i++)
+		{
+			FString TagString;
+			TArray<FString> PathStrings;
+			Ar << TagString << PathStrings;
+
+			TArray<FSoftObjectPath>& Assets = Model.TagAssets.Add(FName(*TagString));
+			Assets.Reserve(PathStrings.Num());
+
+			for (const FString& PathString : PathStrings)
+			{
+				Assets.Add(FSoftObjectPath(PathString));
+			}
+		}
+	}
+	else
+	{
+		int32 NumTransitions = Model.Transitions.Num();
+		Ar << NumTransitions;
+
+		for (TPair<FName, TMap<FName, int32>>& Transition : Model.Transitions)
+		{
+			FString TagString = Transition.Key.ToString();
+			int32 NumNextTags = Transition.Value.Num();
+			Ar << TagString << NumNextTags;
+
+			for (TPair<FName, int32>& NextTag : Transition.Value)
+			{
+				FString NextTagString = NextTag.Key.ToString();
+				Ar << NextTagString << NextTag.Value;
+			}
+		}
+
+		int32 NumTags = Model.TagAssets.Num();
+		Ar << NumTags;
+
+		for (TPair<FName, TArray<FSoftObjectPath>>& Tag : Model.TagAssets)
+		{
+			FString TagString = Tag.Key.ToString();
+			TArray<FString> PathStrings;
+			PathStrings.Reserve(Tag.Value.Num());
+
+			for (const FSoftObjectPath& AssetPath : Tag.Value)
+			{
+				PathStrings.Add(AssetPath.ToString());
+			}
+
+			Ar << TagString << PathStrings;
+		}
+	}
+
+	return Ar;
+}
@@ -0,0 +1,39 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "ResidencySnapshotADAM.h"
+
+FResidencySnapshotChannelADAM::~FResidencySnapshotChannelADAM()
+{
+	if (const FResidencySnapshotADAM* Snapshot = Current.exchange(nullptr))
+	{
+		Snapshot->Release();
+	}
+}
+
+FResidencySnapshotRefADAM FResidencySnapshotChannelADAM::Acquire() const
+{
+	// The publisher does not release a replaced snapshot while a reader may still be taking its reference
+	NumAcquiring.fetch_add(1);
+
+	FResidencySnapshotRefADAM Snapshot(Current.load());
+
+	NumAcquiring.fetch_sub(1);
+
+	return Snapshot;
+}
+
+FResidencySnapshotRefADAM FResidencySnapshotChannelADAM::Publish(FResidencySnapshotRefADAM Snapshot)
+{
+	const FResidencySnapshotADAM* NewSnapshot = Snapshot.GetReference();
+
+	// The channel holds its own reference to the current snapshot
+	if (NewSnapshot)
+	{
+		NewSnapshot->AddRef();
+	}
+
+	const FResidencySnapshotADAM* PreviousSnapshot = Current.exchange(NewSnapshot);
+
+	// The reference of the channel is handed over to the caller
+	return FResidencySnapshotRefADAM(PreviousSnapshot, false);
+}
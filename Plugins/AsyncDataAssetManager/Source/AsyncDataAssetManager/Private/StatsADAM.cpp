@@ -0,0 +1,43 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "StatsADAM.h"
+
+DEFINE_STAT(STAT_LoadArrayADAM);
+DEFINE_STAT(STAT_UnloadAllTagsADAM);
+DEFINE_STAT(STAT_TickPostLoadADAM);
+DEFINE_STAT(STAT_OnLoadedADAM);
+DEFINE_STAT(STAT_FindNestedAssetsADAM);
+DEFINE_STAT(STAT_EvictADAM);
+DEFINE_STAT(STAT_GetDataADAM);
+DEFINE_STAT(STAT_GetCollectionByTagADAM);
+DEFINE_STAT(STAT_GetDataByClassADAM);
+
+DEFINE_STAT(STAT_NumStoredADAM);
+DEFINE_STAT(STAT_NumInFlightADAM);
+DEFINE_STAT(STAT_NumPostLoadADAM);
+DEFINE_STAT(STAT_NumLoadBatchesADAM);
+DEFINE_STAT(STAT_NumCoolingADAM);
+
+DEFINE_STAT(STAT_ResidentSizeADAM);
+DEFINE_STAT(STAT_CoolingResidentSizeADAM);
+
+UE_TRACE_CHANNEL_DEFINE(ADAMChannel);
+
+UE_TRACE_EVENT_BEGIN(ADAM, DataAssetLoaded)
+	UE_TRACE_EVENT_FIELD(uint64, RequestCycle)
+	UE_TRACE_EVENT_FIELD(uint64, CompleteCycle)
+	UE_TRACE_EVENT_FIELD(int32, RecursiveDepth)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Tag)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, AssetPath)
+UE_TRACE_EVENT_END()
+
+void TraceDataAssetLoadedADAM(const FSoftObjectPath& AssetPath, FName Tag, int32 RecursiveDepthLoading, uint64 RequestCycles)
+{
+	// The strings are only built while the channel is enabled
+	UE_TRACE_LOG(ADAM, DataAssetLoaded, ADAMChannel)
+		<< DataAssetLoaded.RequestCycle(RequestCycles)
+		<< DataAssetLoaded.CompleteCycle(FPlatformTime::Cycles64())
+		<< DataAssetLoaded.RecursiveDepth(RecursiveDepthLoading)
+		<< DataAssetLoaded.Tag(*Tag.ToString())
+		<< DataAssetLoaded.AssetPath(*AssetPath.ToString());
+}
@@ -0,0 +1,51 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+/**
+ * Stats of the ADAM subsystem, shown by "stat ADAM".
+ *
+ * Cycle counters cover the public API and the post-load processing, the storage counters are updated once per frame.
+ */
+DECLARE_STATS_GROUP(TEXT("ADAM"), STATGROUP_ADAM, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Array"), STAT_LoadArrayADAM, STATGROUP_ADAM, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Unload All Tags"), STAT_UnloadAllTagsADAM, STATGROUP_ADAM, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Post Load Tick"), STAT_TickPostLoadADAM, STATGROUP_ADAM, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("On Loaded"), STAT_OnLoadedADAM, STATGROUP_ADAM, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Nested Assets"), STAT_FindNestedAssetsADAM, STATGROUP_ADAM, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Evict"), STAT_EvictADAM, STATGROUP_ADAM, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Data"), STAT_GetDataADAM, STATGROUP_ADAM, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Collection By Tag"), STAT_GetCollectionByTagADAM, STATGROUP_ADAM, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Data By Class"), STAT_GetDataByClassADAM, STATGROUP_ADAM, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Stored Data Assets"), STAT_NumStoredADAM, STATGROUP_ADAM, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("In-Flight Requests"), STAT_NumInFlightADAM, STATGROUP_ADAM, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Post-Load Queue"), STAT_NumPostLoadADAM, STATGROUP_ADAM, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Array Loads"), STAT_NumLoadBatchesADAM, STATGROUP_ADAM, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Cooling Data Assets"), STAT_NumCoolingADAM, STATGROUP_ADAM, );
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Stored Resident Size"), STAT_ResidentSizeADAM, STATGROUP_ADAM, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Cooling Resident Size"), STAT_CoolingResidentSizeADAM, STATGROUP_ADAM, );
+
+/**
+ * Trace channel of the ADAM subsystem. Enable it with "-trace=default,ADAM" or "Trace.Enable ADAM".
+ *
+ * Each completed request is recorded as an "ADAM.DataAssetLoaded" event with its request and completion cycles,
+ * so load latency percentiles can be computed from a capture per tag and depth.
+ */
+UE_TRACE_CHANNEL_EXTERN(ADAMChannel);
+
+/**
+ * Records the completion of a request in the trace channel.
+ *
+ * @param AssetPath Loaded Data Asset.
+ * @param Tag Owner the Data Asset is loaded for.
+ * @param RecursiveDepthLoading Remaining depth of the recursive loading of the requester.
+ * @param RequestCycles Value of FPlatformTime::Cycles64() when the request was made.
+ */
+void TraceDataAssetLoadedADAM(const FSoftObjectPath& AssetPath, FName Tag, int32 RecursiveDepthLoading, uint64 RequestCycles);
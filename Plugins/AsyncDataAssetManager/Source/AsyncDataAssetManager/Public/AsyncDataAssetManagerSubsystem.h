@@ -5,8 +5,17 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Engine/StreamableManager.h"
+#include "Containers/Ticker.h"
+#include "Templates/Identity.h"
+#include "UObject/PrimaryAssetId.h"
 #include "GameplayTagsManager.h"
 #include "GameplayTagContainer.h"
+#include "DataStorageADAM.h"
+#include "NestedManifestADAM.h"
+#include "PrefetchModelADAM.h"
+#include "LoadTraceADAM.h"
+#include "ResidencySnapshotADAM.h"
+#include "AsyncTechnologiesSettings.h"
 
 #include "AsyncDataAssetManagerSubsystem.generated.h"
 
@@ -27,6 +36,25 @@ class UPrimaryDataAsset;
  * avoid duplicates in memory. Additionally, if you change a tag, the entire data 
  * package will share the specified tag.
  * 
+ * *** Shared data ***
+ * Each Data Asset is stored once. Loading it with another tag adds the tag to its owners
+ * without a new request, and unloading a tag frees the memory only after the last owner is gone.
+ * With the "Manifest" or "Asset Registry" nested discovery, the known nested data
+ * is requested together with the parent in a single batch.
+ * 
+ * *** Memory budget ***
+ * Each stored Data Asset tracks its resident size and the time of its last access.
+ * When the configured budget is exceeded or the engine reports memory pressure,
+ * the least recently used data of the evictable tiers is unloaded automatically.
+ * 
+ * *** Cooling pool ***
+ * With a grace period configured for the tag, unloaded data is kept in the cooling pool
+ * for the specified time. A reload during this time is served from memory without a new request.
+ * 
+ * *** Residency snapshot ***
+ * With the residency snapshot enabled, an immutable snapshot of the resident data is published after
+ * each frame in which the data changed. Worker threads read it without locks and without the game thread.
+ * 
  * *** Only for the array load function ***
  * The "Notify After Full Loaded" option, together with the "On All Loaded" event, 
  * allows you to receive a notification only when all specified data has been loaded.
@@ -63,39 +91,254 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ADAM Subsystem", meta = (ToolTip = "Can be used simultaneously with other tags. The system processes the very first filled tag, starting the check from top to bottom."))
 	FName TagName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ADAM Subsystem", meta = (ToolTip = "If true, each gameplay tag of the container also covers all of its child tags in the gameplay tag hierarchy."))
+	bool bIncludeChildGameplayTags = false;
+};
+
+// Designed to output information about the current storage of data assets.
+USTRUCT(BlueprintType)
+struct FMirrorADAM
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Data asset name."))
+	FString PrimaryDataAssetName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Soft link to data asset."))
+	TSoftObjectPtr<UPrimaryDataAsset> SoftReference;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Designed for data grouping. The first tag that loaded the data asset."))
+	FName Tag;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "All tags sharing the data asset. The data asset is unloaded by tag only after the last of them."))
+	TArray<FName> Owners;
 };
 
-// The main structure of the ADAM subsystem.
+// Completed asynchronous load waiting for post-load processing.
 USTRUCT()
-struct FMemoryADAM
+struct FPostLoadADAM
 {
 	GENERATED_USTRUCT_BODY()
 
 public:
 	UPROPERTY()
 	TSoftObjectPtr<UPrimaryDataAsset> SoftReference;
-	
-	TSharedPtr<FStreamableHandle> MemoryReference;
 
 	UPROPERTY()
 	FName Tag;
+
+	UPROPERTY()
+	int32 RecursiveDepthLoading = 0;
+
+	UPROPERTY()
+	int32 Priority = 0;
+
+	UPROPERTY()
+	bool NotifyAfterFullLoaded = false;
+
+	// Native request to report the load to. '0' if the load is reported by the subsystem delegates.
+	UPROPERTY()
+	int32 RequestId = 0;
+
+	// Array load the Data Asset belongs to. '0' if the load is not part of an array load.
+	UPROPERTY()
+	int32 BatchId = 0;
+
+	// Nested data was requested together with the Data Asset. The depth is only reported, no nested data search is made.
+	UPROPERTY()
+	bool IsNestedRequested = false;
+};
+
+// Requester attached to a load in progress.
+struct FInFlightRequesterADAM
+{
+	// Owner of the stored Data Asset
+	FName Tag;
+
+	int32 RecursiveDepthLoading = 0;
+
+	int32 Priority = 0;
+
+	bool NotifyAfterFullLoaded = false;
+
+	// Native request of the requester. '0' for requests of the Blueprint API.
+	int32 RequestId = 0;
+
+	// Array load of the requester. '0' if the request is not part of an array load.
+	int32 BatchId = 0;
+
+	// Nested data is requested together with the Data Asset from the known closure
+	bool IsNestedRequested = false;
+
+	// Time of the request in cycles, recorded in the trace channel when the Data Asset is loaded
+	uint64 RequestCycles = FPlatformTime::Cycles64();
 };
 
-// Designed to output information about the current storage of data assets.
+// Request of the native C++ API. Callbacks are called directly, without the subsystem delegates.
+struct FNativeRequestADAM
+{
+	// Called for each requested Data Asset after it is loaded. Receives nullptr if the Data Asset can't be loaded.
+	TFunction<void(UPrimaryDataAsset*)> OnLoaded;
+
+	// Called once after all requested Data Assets are loaded
+	TFunction<void()> OnCompleted;
+
+	// Number of requested Data Assets that are not reported yet
+	int32 NumPending = 0;
+};
+
+// Load in progress, shared by all requesters of the same Data Asset.
+struct FInFlightADAM
+{
+	// Descriptor of the request. Not set for Data Assets of a batch, the batch descriptor is stored separately.
+	TSharedPtr<FStreamableHandle> StreamableHandle;
+
+	// Each requester receives its own completion notification
+	TArray<FInFlightRequesterADAM> Requesters;
+
+	// Key of the batch descriptor the Data Asset is loaded by. '0' if the Data Asset has its own descriptor.
+	int32 BatchKey = 0;
+};
+
+// Array load tracked from the request to the post-load processing of all its Data Assets, including the nested ones.
+struct FLoadBatchADAM
+{
+	FName Tag;
+
+	bool NotifyAfterFullLoaded = false;
+
+	// Data Assets that are not processed yet
+	TSet<FSoftObjectPath> PendingPaths;
+
+	// Nested data searches that can still add Data Assets to the batch
+	int32 NumPendingSearches = 0;
+
+	// Data Assets that have been processed or released
+	int32 NumCompleted = 0;
+
+	bool IsComplete() const { return PendingPaths.IsEmpty() && NumPendingSearches == 0; }
+};
+
+// Unloaded Data Asset kept in memory for the grace period of its tags.
+struct FCoolingADAM
+{
+	// Keeps the Data Asset in memory until the grace period expires
+	TSharedPtr<FStreamableHandle> StreamableHandle;
+
+	double ExpireTime = 0.0;
+
+	int64 ResidentSize = INDEX_NONE;
+
+	int32 Priority = 0;
+};
+
+// Data Asset loaded speculatively for the predicted next tag.
+struct FPrefetchADAM
+{
+	// Keeps the Data Asset in memory until it is requested or the lifetime expires
+	TSharedPtr<FStreamableHandle> StreamableHandle;
+
+	double ExpireTime = 0.0;
+};
+
+// Bundle state of a stored Primary Asset. The bundles are kept in memory by the Asset Manager.
+struct FPrimaryBundlesADAM
+{
+	FPrimaryAssetId PrimaryAssetId;
+
+	// Bundles requested for the Primary Asset
+	TArray<FName> Bundles;
+
+	// True if the Primary Asset was requested through the Asset Manager together with its bundles
+	bool IsRequested = false;
+};
+
+// Read-only view of a stored Data Asset for the native C++ API. Refers to the storage of the subsystem, nothing is copied.
+struct FResidencyViewADAM
+{
+	FHandleADAM Handle;
+
+	const FSoftObjectPath& AssetPath;
+
+	// Tags owning the Data Asset, in the order they were added
+	const TArray<FName>& Owners;
+
+	// nullptr if the Data Asset has not finished loading
+	UObject* LoadedAsset = nullptr;
+
+	// INDEX_NONE if the size has not been measured yet
+	int64 ResidentSize = INDEX_NONE;
+};
+
+// Published residency snapshot together with the objects it keeps alive.
+struct FPublishedSnapshotADAM
+{
+	FResidencySnapshotRefADAM Snapshot;
+
+	// Loaded objects of the snapshot, referenced by the subsystem until the snapshot is reclaimed
+	TArray<TObjectPtr<UObject>> Objects;
+};
+
+class UAsyncDataAssetManagerSubsystem;
+
+/**
+ * Typed handle of a request of the native C++ API.
+ * Does not keep the data in memory, the data stays stored in the ADAM subsystem under the tag of the request.
+ */
+template<typename T>
+struct TRequestADAM
+{
+	TRequestADAM() = default;
+
+	TRequestADAM(UAsyncDataAssetManagerSubsystem* InSubsystem, int32 InRequestId)
+		: Subsystem(InSubsystem)
+		, RequestId(InRequestId)
+	{
+	}
+
+	// Checks whether the request has been issued.
+	bool IsSet() const { return RequestId != 0; }
+
+	// Checks whether the callbacks of the request are still expected.
+	bool IsPending() const;
+
+	// Drop the callbacks of the request. Data that is being loaded continues loading for the tag.
+	void Cancel();
+
+	int32 GetRequestId() const { return RequestId; }
+
+private:
+	TWeakObjectPtr<UAsyncDataAssetManagerSubsystem> Subsystem;
+
+	int32 RequestId = 0;
+};
+
+// Accuracy of the predictive prefetch since the start of the subsystem.
 USTRUCT(BlueprintType)
-struct FMirrorADAM
+struct FPrefetchStatsADAM
 {
 	GENERATED_USTRUCT_BODY()
 
 public:
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Data asset name."))
-	FString PrimaryDataAssetName;
+	UPROPERTY(BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Number of predictions of the next tag."))
+	int32 NumPredictions = 0;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Soft link to data asset."))
-	TSoftObjectPtr<UPrimaryDataAsset> SoftReference;
+	UPROPERTY(BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Number of prefetched Data Assets."))
+	int32 NumPrefetched = 0;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Designed for data grouping."))
-	FName Tag;
+	UPROPERTY(BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Number of prefetched Data Assets that were requested in time."))
+	int32 NumHits = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Number of prefetched Data Assets released without a request."))
+	int32 NumWasted = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Resident size of the wasted Data Assets in bytes. Data Assets released before they are loaded are not counted."))
+	int64 WastedBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Share of the prefetched Data Assets that were requested, from 0 to 1."))
+	float Accuracy = 0.0f;
 };
 
 #pragma endregion STRUCTS
@@ -114,10 +357,14 @@ public:
 	virtual void Deinitialize() override;
 	//~End USubsystem
 
+	//~UObject
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	//~End UObject
+
 #pragma region DELEGATES
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnLoadedADAM, UPrimaryDataAsset*, LoadedObject, TSoftObjectPtr<UPrimaryDataAsset>, LoadedPrimaryDataAsset, FName, LoadedTag, int32, RecursiveDepthLoading);
 
-	// Indicates that the load is complete
+	// Indicates that the load is complete. Only broadcast with the "Per-asset load event" setting, otherwise use OnFrameLoadedADAM.
 	UPROPERTY(BlueprintAssignable, Category = "ADAM Subsystem")
 	FOnLoadedADAM OnLoadedADAM;
 
@@ -127,16 +374,50 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "ADAM Subsystem")
 	FOnAllLoadedADAM OnAllLoadedADAM;
 
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnBatchLoadedADAM, int32, BatchId, FName, LoadedTag);
+
+	// Indicates that all data of the array load is complete, including its nested data. Reported for each array load separately.
+	UPROPERTY(BlueprintAssignable, Category = "ADAM Subsystem")
+	FOnBatchLoadedADAM OnBatchLoadedADAM;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFrameLoadedADAM, const TArray<FMirrorADAM>&, LoadedDataAssets);
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPreloadedADAM);
+
+	// Indicates that all data of the startup preload is stored, including its nested data
+	UPROPERTY(BlueprintAssignable, Category = "ADAM Subsystem")
+	FOnPreloadedADAM OnPreloadedADAM;
+
+	// Indicates all loads processed during the frame with a single notification
+	UPROPERTY(BlueprintAssignable, Category = "ADAM Subsystem")
+	FOnFrameLoadedADAM OnFrameLoadedADAM;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEvictedADAM, TSoftObjectPtr<UPrimaryDataAsset>, EvictedPrimaryDataAsset, const TArray<FName>&, EvictedOwners);
+
+	// Indicates that the data was unloaded automatically to free memory
+	UPROPERTY(BlueprintAssignable, Category = "ADAM Subsystem")
+	FOnEvictedADAM OnEvictedADAM;
+
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBundleStateChangedADAM, FPrimaryAssetId, PrimaryAssetId);
+
+	// Indicates that the bundles added to a stored Primary Asset are loaded
+	UPROPERTY(BlueprintAssignable, Category = "ADAM Subsystem")
+	FOnBundleStateChangedADAM OnBundleStateChangedADAM;
+
 #pragma endregion DELEGATES
 
 	/**
-	 * The main array of the ADAM subsystem. 
+	 * The main storage of the ADAM subsystem. 
 	 * Suljit as a soft link store for all asynchronously loaded data assets.
+	 * Entries are addressed by stable slot indexes and handles.
 	 */
-	TArray<FMemoryADAM> DataADAM;
+	FDataStorageADAM DataADAM;
 
-	// Auxiliary array responsible for the safety of parallel asynchronous loading in real-time.
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Auxiliary array responsible for the safety of parallel asynchronous loading in real-time."))
+	/**
+	 * Names of the Data Assets that are being loaded.
+	 * Only mirrors the in-flight table for Blueprint compatibility and is not used by the subsystem. Rebuilt at most once per frame, use IsLoadingADAM instead.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Deprecated. Names of the Data Assets that are being loaded, kept for Blueprint compatibility. Updated once per frame and names are not unique, use IsLoadingADAM instead."))
 	TArray<FString> QueueADAM;
 
 #pragma region BLUEPRINT_FUNCTIONS
@@ -145,6 +426,7 @@ public:
 	 * @param PrimaryDataAsset Soft link to data asset.
 	 * @param Tag Designed for data grouping.
 	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority passed to the StreamableManager. Higher values are loaded first. Nested data assets inherit the priority, decreased by the "Recursive priority decay" setting for each level of depth.
 	 * @return ReturnPrimaryDataAsset - Returns the same data asset as that specified in the first parameter.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
@@ -152,23 +434,84 @@ public:
 			TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset,
 			FTagADAM Tag,
 			int32 RecursiveDepthLoading,
-			TSoftObjectPtr<UPrimaryDataAsset>& ReturnPrimaryDataAsset);
+			TSoftObjectPtr<UPrimaryDataAsset>& ReturnPrimaryDataAsset,
+			int32 Priority = 0);
 
 	/**
 	 * Async loading of an array of Data Asset and storing each element in memory.
 	 * @param PrimaryDataAssets Soft link to data assets.
 	 * @param Tag Designed for data grouping.
-	 * @param NotifyAfterFullLoaded If true, the "OnAllLoaded" event will notify you when all data in the array has been fully loaded. The ADAM system will ignore duplicate checks (to prevent accidental unloading of necessary data through another thread), so all Data Asset duplicates will be controlled by the engine's base system.
+	 * @param NotifyAfterFullLoaded If true, the "OnAllLoaded" event will notify you when all data in the array has been fully loaded. Data Assets that are already stored are shared with the tag and are also included in the notification.
 	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority passed to the StreamableManager. Higher values are loaded first. Nested data assets inherit the priority, decreased by the "Recursive priority decay" setting for each level of depth.
 	 * @result ReturnPrimaryDataAssets - Returns the same data asset as that specified in the first parameter.
+	 * @return ID of the array load. Use it to track the progress, cancel the load, and match the "OnBatchLoaded" event.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
-	void LoadArrayADAM(
+	int32 LoadArrayADAM(
 			TArray<TSoftObjectPtr<UPrimaryDataAsset>> PrimaryDataAssets, 
 			FTagADAM Tag,
 			bool NotifyAfterFullLoaded,
 			int32 RecursiveDepthLoading,
-			TArray<TSoftObjectPtr<UPrimaryDataAsset>>& ReturnPrimaryDataAssets);
+			TArray<TSoftObjectPtr<UPrimaryDataAsset>>& ReturnPrimaryDataAssets,
+			int32 Priority = 0);
+
+	/**
+	 * Raises the loading priority of a Data Asset that is still being loaded.
+	 * The priority of a request in progress can only be raised. Already loaded data is not affected.
+	 * The request of the StreamableManager keeps its priority, only its packages already queued in the package loader are raised.
+	 * 
+	 * @param PrimaryDataAsset Soft link to data asset.
+	 * @param Priority New loading priority.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void ReprioritizeADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, int32 Priority);
+
+	/**
+	 * Raises the loading priority of all Data Assets with the specified tag that are still being loaded.
+	 * The priority of a request in progress can only be raised. Already loaded data is not affected.
+	 * The request of the StreamableManager keeps its priority, only its packages already queued in the package loader are raised.
+	 * 
+	 * @param Tag Designed for data grouping.
+	 * @param Priority New loading priority.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void ReprioritizeTagADAM(FTagADAM Tag, int32 Priority);
+
+	/**
+	 * Cancels the array load. Outstanding requests of the load are cancelled and its pending nested data searches are skipped.
+	 * Data Assets that are already loaded stay in memory with the tag. Data Assets shared with other requests keep loading for them.
+	 * No completion is reported for the cancelled load.
+	 * 
+	 * @param BatchId ID returned by LoadArrayADAM.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void CancelBatchADAM(int32 BatchId);
+
+	/**
+	 * Returns the progress of the array load from 0 to 1, aggregated from the descriptors of its outstanding requests.
+	 * Nested data is included once it is found. Completed, cancelled and unknown loads return 1.
+	 * 
+	 * @param BatchId ID returned by LoadArrayADAM.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	float GetBatchProgressADAM(int32 BatchId);
+
+	/**
+	 * Checks whether the array load is still in progress.
+	 * 
+	 * @param BatchId ID returned by LoadArrayADAM.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	bool IsBatchLoadingADAM(int32 BatchId);
+
+	/**
+	 * Checks whether the startup preload from the plugin settings is complete.
+	 * The preload starts with the game instance and can complete before the "OnPreloadedADAM" event is bound, so check it first.
+	 * Returns true if nothing is preloaded.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	bool IsPreloadedADAM();
 
 	/**
 	 * Loading a Data Asset without storing it in memory.
@@ -179,7 +522,7 @@ public:
 	void FastLoadADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, TSoftObjectPtr<UPrimaryDataAsset>& ReturnPrimaryDataAsset);
 
 	/**
-	 * Unload one Data Asset from array and memory.
+	 * Unload one Data Asset from array and memory. The Data Asset is unloaded for all tags sharing it.
 	 * 
 	 * @param PrimaryDataAsset Soft link to data asset.
 	 * @param ForcedUnload If false, the function call will stop loading the Data Asset
@@ -200,6 +543,7 @@ public:
 
 	/**
 	 * Unload all data assets with the specified tag from the array and memory. Unloading in descending order.
+	 * Data assets shared with other tags only lose the specified tags and stay in memory.
 	 * @param Tag Alternative deletion option. If this value is changed, all Data Assets with the specified tag will be removed from memory.
 	 * @param ForcedUnload If false, the function call will stop loading the Data Asset
 	 * asynchronously and will make the target resource available for memory freeing,
@@ -210,6 +554,7 @@ public:
 
 	/**
 	 * Returns the ADAM mirror array formed it the main array with a reference to the destructor.
+	 * The array is built on each call. When polling, rebuild it only if GetGenerationADAM has changed.
 	 * @return Returns a mirrored array of DataADAM.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
@@ -222,6 +567,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
 	TMap<FName, int32> GetCollectionByTagADAM();
 
+	/**
+	 * Returns the number of data items stored in the ADAM system with the specified tag.
+	 * 
+	 * @param Tag The tag to count the data assets.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	int32 GetNumByTagADAM(FTagADAM Tag);
+
 	/**
 	 * Returns a pointer to the Data Asset ADAM object stored in memory.
 	 * 
@@ -232,7 +585,8 @@ public:
 	UObject* GetObjectDataADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, bool& IsValid);
 
 	/**
-	 * Returns the index from the array of the ADAM data asset collection. If nothing is found returns -1.
+	 * Returns the slot index from the storage of the ADAM data asset collection. If nothing is found returns -1.
+	 * The index stays the same until the data asset is unloaded.
 	 * 
 	 * @param PrimaryDataAsset Soft link to data asset.
 	 */
@@ -240,124 +594,990 @@ public:
 	int32 GetIndexDataADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset);
 
 	/**
-	 * Selects a data array from the shared storage based on the specified class and tag.
+	 * Checks whether the data asset is being loaded. Repeated load requests of such data asset are attached to the load in progress.
 	 * 
-	 * @param DataAssetClass The data asset class to filter by.
-	 * @param Tag The tag to filter the data assets.
-	 * @param bIgnoreTag If true, the tag will not be checked.
-	 * @return Returns an array of data assets that match the specified class and tag.
+	 * @param PrimaryDataAsset Soft link to data asset.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
-	TArray<TSoftObjectPtr<UPrimaryDataAsset>> GetDataByClassADAM(TSubclassOf<UPrimaryDataAsset> DataAssetClass, FName Tag, bool bIgnoreTag = true);
-
-#pragma endregion BLUEPRINT_FUNCTIONS
-
-protected:
-	// Determines the type of string and returns it in FName. If all variables contain an empty string, returns NAME_None.
-	UFUNCTION()
-	FName GetTagNameFromStruct(FTagADAM& Tag);
-
-private:
-	UPROPERTY()
-	bool EnableLog = false;
-
-	UPROPERTY()
-	TMap<FName, int32> QueueCounterADAM;
-
-	// Searching nested data assets
-	UFUNCTION()
-	TArray<TSoftObjectPtr<UPrimaryDataAsset>> FindNestedAssets(UPrimaryDataAsset* DataAsset);
+	bool IsLoadingADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset);
 
 	/**
-	 * Recursive function for searching nested data assets.
+	 * Returns the tags sharing the data asset stored in the ADAM subsystem.
 	 * 
-	 * @param Container Pointer to the memory of the struct or object instance being inspected.
-	 * @param Struct Reflection metadata describing the type of the container (UStruct or UClass).
-	 * @param OutNestedAssets Array to collect discovered nested PrimaryDataAssets.
-	 * @param UniqueAssetNames Set of asset names used to prevent duplicates when collecting assets.
+	 * @param PrimaryDataAsset Soft link to data asset.
 	 */
-	void FindNestedAssetsRecursive(void* Container, UStruct* Struct, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& OutNestedAssets, TSet<FString>& UniqueAssetNames);
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	TArray<FName> GetOwnersADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset);
 
 	/**
-	 * Add data to the main DataADAM array
+	 * Returns the stable handle of the data asset stored in the ADAM subsystem. If nothing is found returns an unset handle.
+	 * 
 	 * @param PrimaryDataAsset Soft link to data asset.
-	 * @param DataAssetHandle Data Asset Descriptor.
-	 * @param Tag Designed for data grouping.
 	 */
-	void AddDataToArrayADAM(
-			TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset,
-			TSharedPtr<FStreamableHandle> DataAssetHandle,
-			FName Tag);
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	FHandleADAM GetHandleDataADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset);
 
 	/**
-	 * Single asynchronous loading with completion notification
+	 * Checks whether the data asset of the handle is still stored in the ADAM subsystem.
 	 * 
-	 * @param PrimaryDataAsset Soft link to data asset.
-	 * @param Tag Designed for data grouping.
-	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Handle Handle received from GetHandleDataADAM.
 	 */
-	UFUNCTION()
-	void AddToADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading);
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	bool IsValidHandleADAM(FHandleADAM Handle);
 
 	/**
-	 * Multiple asynchronous loading with completion notification
+	 * Selects a data array from the shared storage based on the specified class and tag.
+	 * Only data assets that have finished loading are returned.
 	 * 
-	 * Unlike the AddToADAM() function, this function allows loading the same Data Asset
-	 * using FStreamableManager. If the Data Asset is already being loaded or is loaded,
-	 * FStreamableManager will not load it again. Instead, it will increase the reference
-	 * count for this resource. When all references to the resource are removed, 
-	 * FStreamableManager will free the memory occupied by this resource.
+	 * @param DataAssetClass The data asset class to filter by.
+	 * @param Tag The tag to filter the data assets.
+	 * @param bIgnoreTag If true, the tag will not be checked.
+	 * @return Returns an array of data assets that match the specified class and tag.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	TArray<TSoftObjectPtr<UPrimaryDataAsset>> GetDataByClassADAM(TSubclassOf<UPrimaryDataAsset> DataAssetClass, FName Tag, bool bIgnoreTag = true);
+
+	/**
+	 * Returns the resident size of the data asset stored in the ADAM subsystem in bytes. If the data asset is not loaded yet returns -1.
+	 * The size includes the subobjects of the data asset. Nested data assets are stored separately and have their own size.
 	 * 
 	 * @param PrimaryDataAsset Soft link to data asset.
-	 * @param Tag Designed for data grouping.
-	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
 	 */
-	UFUNCTION()
-	void AddAllToADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading);
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	int64 GetResidentSizeADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset);
 
 	/**
-	* Delegate notification after loading Data Asset into ADAM subsystem
-	* 
-	* @param PrimaryDataAsset Soft link to data asset.
-	* @param Tag Designed for data grouping.
-	* @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
-	* 
-	* PrimaryDataAsset - a soft link with a generic suffix.
-	* Tag - a given tag for grouping data.
-	* RecursiveDepthLoading - whether the recursive option was selected during loading.
-	*/
-	UFUNCTION()
-	void OnLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading);
+	 * Returns the resident size of all data assets stored in the ADAM subsystem in bytes, including the cooling pool.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	int64 GetTotalResidentSizeADAM();
 
 	/**
-	 * Delegate notification after full loading Data Asset into ADAM subsystem
+	 * Overrides the eviction tier of the data owned by the tag. When memory has to be freed, lower tiers are evicted first.
 	 * 
-	 * @param PrimaryDataAsset Soft link to data asset.
 	 * @param Tag Designed for data grouping.
-	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
-	 * 
-	 * PrimaryDataAsset - a soft link with a generic suffix.
-	 * Tag - a given tag for grouping data.
-	 * RecursiveDepthLoading - whether the recursive option was selected during loading.
+	 * @param EvictionTier New eviction tier of the tag.
 	 */
-	UFUNCTION()
-	void OnAllLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading);
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void SetEvictionTierADAM(FTagADAM Tag, EEvictionTierADAM EvictionTier);
 
 	/**
-	 * Remove Data Asset from the ADAM array and asynchronously unload it.
-	 * 
-	 * @param ForcedUnload If false, the function call will stop loading the Data Asset
+	 * Responds as if the engine reported memory pressure. The least recently used data of the evictable tiers is unloaded
+	 * until the resident size drops to the "Memory pressure target" setting.
+	 * The same response can be triggered for all game instances with the "ADAM.SimulateMemoryPressure" console command.
 	 */
-	UFUNCTION()
-	void RemoveFromADAM(int32 DataAssetIndex, bool ForcedUnload);
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void SimulateMemoryPressureADAM();
 
 	/**
-	 * Asynchronous recursive loading of Data Asset
+	 * Overrides the grace period of the data owned by the tag. Unloaded data is kept in the cooling pool for this time.
 	 * 
-	 * @param PrimaryDataAsset Soft link to data asset.
 	 * @param Tag Designed for data grouping.
-	 * @param NotifyAfterFullLoaded If true, the "OnAllLoaded" event will notify you when all data in the array has been fully loaded. The ADAM system will ignore duplicate checks (to prevent accidental unloading of necessary data through another thread), so all Data Asset duplicates will be controlled by the engine's base system.
+	 * @param GracePeriod Time in seconds. If the value is set to '0', data of the tag is unloaded immediately.
 	 */
-	UFUNCTION()
-	void RecursiveLoad(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading);
-};
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void SetGracePeriodADAM(FTagADAM Tag, float GracePeriod);
+
+	/**
+	 * Checks whether the unloaded data asset is still kept in the cooling pool. A reload of such data asset is served from memory.
+	 * 
+	 * @param PrimaryDataAsset Soft link to data asset.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	bool IsCoolingADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset);
+
+	/**
+	 * Releases all data assets of the cooling pool without waiting for their grace periods.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void ClearCoolingADAM();
+
+	/**
+	 * Async loading of a Primary Asset with the specified bundles and storing it in memory.
+	 * Only the assets of the requested bundles are loaded together with the Primary Asset, the rest of its soft references stay unloaded.
+	 * The bundles are released together with the Primary Asset.
+	 * 
+	 * @param PrimaryAssetId Primary Asset ID known to the Asset Manager.
+	 * @param Tag Designed for data grouping.
+	 * @param Bundles Bundles to load, for example "Game" on servers and "Game" and "UI" on clients.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite. Nested data assets are loaded without bundles.
+	 * @param Priority Loading priority passed to the StreamableManager.
+	 * @return ReturnPrimaryDataAsset - Returns the soft link to the Primary Asset.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void LoadPrimaryADAM(
+			FPrimaryAssetId PrimaryAssetId,
+			FTagADAM Tag,
+			TArray<FName> Bundles,
+			int32 RecursiveDepthLoading,
+			TSoftObjectPtr<UPrimaryDataAsset>& ReturnPrimaryDataAsset,
+			int32 Priority = 0);
+
+	/**
+	 * Async loading of an array of Primary Assets with the specified bundles and storing each element in memory.
+	 * Bundles of Primary Assets that are already stored or requested in a batch are loaded separately and reported by the "OnBundleStateChanged" event.
+	 * 
+	 * @param PrimaryAssetIds Primary Asset IDs known to the Asset Manager.
+	 * @param Tag Designed for data grouping.
+	 * @param Bundles Bundles to load for each Primary Asset.
+	 * @param NotifyAfterFullLoaded If true, the "OnAllLoaded" event will notify you when all data in the array has been fully loaded.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority passed to the StreamableManager.
+	 * @result ReturnPrimaryDataAssets - Returns the soft links to the Primary Assets.
+	 * @return ID of the array load.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	int32 LoadPrimaryArrayADAM(
+			TArray<FPrimaryAssetId> PrimaryAssetIds,
+			FTagADAM Tag,
+			TArray<FName> Bundles,
+			bool NotifyAfterFullLoaded,
+			int32 RecursiveDepthLoading,
+			TArray<TSoftObjectPtr<UPrimaryDataAsset>>& ReturnPrimaryDataAssets,
+			int32 Priority = 0);
+
+	/**
+	 * Changes the bundles of a stored Primary Asset. The "OnBundleStateChanged" event notifies when the added bundles are loaded.
+	 * 
+	 * @param PrimaryAssetId Primary Asset ID of a stored data asset.
+	 * @param AddBundles Bundles to load.
+	 * @param RemoveBundles Bundles to release.
+	 * @param Priority Loading priority passed to the StreamableManager.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void ChangeBundleStateADAM(FPrimaryAssetId PrimaryAssetId, TArray<FName> AddBundles, TArray<FName> RemoveBundles, int32 Priority = 0);
+
+	/**
+	 * Returns the bundles requested for the stored Primary Asset.
+	 * 
+	 * @param PrimaryAssetId Primary Asset ID of a stored data asset.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	TArray<FName> GetBundleStateADAM(FPrimaryAssetId PrimaryAssetId);
+
+	/**
+	 * Returns the accuracy of the predictive prefetch and the size of the data it loaded in vain.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	FPrefetchStatsADAM GetPrefetchStatsADAM();
+
+	/**
+	 * Releases all prefetched data that has not been requested yet. Released data is counted as wasted.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void ClearPrefetchADAM();
+
+	/**
+	 * Returns the generation of the stored data. It changes whenever a data asset is added, removed, finishes loading or changes its tags.
+	 * Compare it with the previous value to skip rebuilding views of the data if nothing has changed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	int32 GetGenerationADAM();
+
+	/**
+	 * Returns the generation of the data of the tag. It changes whenever a data asset of the tag is added, removed or finishes loading.
+	 * Returns 0 if the tag has never owned data.
+	 * 
+	 * @param Tag Designed for data grouping.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	int32 GetTagGenerationADAM(FTagADAM Tag);
+
+	/**
+	 * Starts recording the loads and unloads of the subsystem. A recording in progress is discarded.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	void StartLoadTraceADAM();
+
+	/**
+	 * Stops recording and saves the trace. It can be replayed by the ReplayLoadTraceADAM commandlet.
+	 * 
+	 * @param FileName Trace file. If empty, the trace is saved to "Saved/ADAM/LoadTraceADAM.bin".
+	 * @return True if the trace is saved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	bool StopLoadTraceADAM(const FString& FileName);
+
+	/**
+	 * Checks whether the loads and unloads of the subsystem are recorded.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "ADAM Subsystem")
+	bool IsLoadTraceRecordingADAM();
+
+#pragma endregion BLUEPRINT_FUNCTIONS
+
+#pragma region NATIVE_FUNCTIONS
+	/**
+	 * Async loading of a Data Asset with a typed callback. The loaded Data Asset is stored in memory as with the Blueprint API.
+	 * The callback is called directly, the OnLoadedADAM event is not broadcast for the request.
+	 * 
+	 * @param PrimaryDataAsset Soft link to data asset.
+	 * @param Tag Designed for data grouping.
+	 * @param OnLoaded Called after the data asset is loaded. Receives nullptr if the data asset can't be loaded or is not of the requested class.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite. Nested data assets are reported by the subsystem delegates.
+	 * @param Priority Loading priority passed to the StreamableManager.
+	 * @return Typed handle of the request.
+	 */
+	template<typename T>
+	TRequestADAM<T> LoadADAM(const TSoftObjectPtr<T>& PrimaryDataAsset, FName Tag, TIdentity_T<TFunction<void(T*)>> OnLoaded, int32 RecursiveDepthLoading = 0, int32 Priority = 0)
+	{
+		static_assert(TIsDerivedFrom<T, UPrimaryDataAsset>::Value, "ADAM can only load Primary Data Assets.");
+
+		TArray<FSoftObjectPath> AssetPaths;
+		AssetPaths.Add(PrimaryDataAsset.ToSoftObjectPath());
+
+		return TRequestADAM<T>(this, RequestNativeADAM(AssetPaths, Tag, RecursiveDepthLoading, Priority, WrapNativeCallbackADAM(MoveTemp(OnLoaded)), nullptr));
+	}
+
+	template<typename T>
+	TRequestADAM<T> LoadADAM(const TSoftObjectPtr<T>& PrimaryDataAsset, FName Tag, TIdentity_T<TDelegate<void(T*)>> OnLoaded, int32 RecursiveDepthLoading = 0, int32 Priority = 0)
+	{
+		return LoadADAM<T>(PrimaryDataAsset, Tag, TFunction<void(T*)>([OnLoaded = MoveTemp(OnLoaded)](T* LoadedObject) { OnLoaded.ExecuteIfBound(LoadedObject); }), RecursiveDepthLoading, Priority);
+	}
+
+	/**
+	 * Async loading of an array of Data Assets with typed callbacks. Each loaded Data Asset is stored in memory as with the Blueprint API.
+	 * The callbacks are called directly, the OnLoadedADAM and OnAllLoadedADAM events are not broadcast for the request.
+	 * 
+	 * @param PrimaryDataAssets Soft links to data assets. Duplicates are reported once.
+	 * @param Tag Designed for data grouping.
+	 * @param OnLoaded Called after each data asset is loaded. Receives nullptr if the data asset can't be loaded or is not of the requested class.
+	 * @param OnAllLoaded Called once after all data assets of the array are loaded.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite. Nested data assets are reported by the subsystem delegates.
+	 * @param Priority Loading priority passed to the StreamableManager.
+	 * @return Typed handle of the request.
+	 */
+	template<typename T>
+	TRequestADAM<T> LoadArrayADAM(const TArray<TSoftObjectPtr<T>>& PrimaryDataAssets, FName Tag, TIdentity_T<TFunction<void(T*)>> OnLoaded, TFunction<void()> OnAllLoaded = nullptr, int32 RecursiveDepthLoading = 0, int32 Priority = 0)
+	{
+		static_assert(TIsDerivedFrom<T, UPrimaryDataAsset>::Value, "ADAM can only load Primary Data Assets.");
+
+		TArray<FSoftObjectPath> AssetPaths;
+		AssetPaths.Reserve(PrimaryDataAssets.Num());
+
+		for (const TSoftObjectPtr<T>& PrimaryDataAsset : PrimaryDataAssets)
+		{
+			AssetPaths.Add(PrimaryDataAsset.ToSoftObjectPath());
+		}
+
+		return TRequestADAM<T>(this, RequestNativeADAM(AssetPaths, Tag, RecursiveDepthLoading, Priority, WrapNativeCallbackADAM(MoveTemp(OnLoaded)), MoveTemp(OnAllLoaded)));
+	}
+
+	template<typename T>
+	TRequestADAM<T> LoadArrayADAM(const TArray<TSoftObjectPtr<T>>& PrimaryDataAssets, FName Tag, TIdentity_T<TDelegate<void(T*)>> OnLoaded, FSimpleDelegate OnAllLoaded = FSimpleDelegate(), int32 RecursiveDepthLoading = 0, int32 Priority = 0)
+	{
+		return LoadArrayADAM<T>(
+			PrimaryDataAssets,
+			Tag,
+			TFunction<void(T*)>([OnLoaded = MoveTemp(OnLoaded)](T* LoadedObject) { OnLoaded.ExecuteIfBound(LoadedObject); }),
+			TFunction<void()>([OnAllLoaded = MoveTemp(OnAllLoaded)]() { OnAllLoaded.ExecuteIfBound(); }),
+			RecursiveDepthLoading,
+			Priority);
+	}
+
+	/**
+	 * Returns the stored Data Asset without a cast and without going through its descriptor.
+	 * 
+	 * @param PrimaryDataAsset Soft link to data asset.
+	 * @return The Data Asset, or nullptr if it is not stored, has not finished loading or is not of the requested class.
+	 */
+	template<typename T>
+	T* GetObjectDataADAM(const TSoftObjectPtr<T>& PrimaryDataAsset)
+	{
+		static_assert(TIsDerivedFrom<T, UPrimaryDataAsset>::Value, "ADAM can only store Primary Data Assets.");
+
+		int32 TargetIndex = DataADAM.FindSlot(PrimaryDataAsset.ToSoftObjectPath());
+		UObject* LoadedAsset = TargetIndex != INDEX_NONE ? DataADAM.GetLoadedAsset(TargetIndex) : nullptr;
+
+		if (!LoadedAsset)
+			return nullptr;
+
+		DataADAM.Touch(TargetIndex);
+
+		return Cast<T>(LoadedAsset);
+	}
+
+	/**
+	 * Calls the function for each stored Data Asset with a view of its entry. Nothing is allocated or copied.
+	 * Don't load or unload data from the function, the storage must not change during the iteration.
+	 * 
+	 * @param Func Called with "const FResidencyViewADAM&".
+	 */
+	template<typename FuncType>
+	void ForEachDataADAM(FuncType&& Func) const
+	{
+		for (TConstSetBitIterator<> It = DataADAM.CreateConstIterator(); It; ++It)
+		{
+			Func(MakeResidencyViewADAM(It.GetIndex()));
+		}
+	}
+
+	/**
+	 * Calls the function for each Data Asset owned by the tag. Only the data of the tag is visited.
+	 * Don't load or unload data from the function, the storage must not change during the iteration.
+	 * 
+	 * @param Tag Owner of the data.
+	 * @param Func Called with "const FResidencyViewADAM&".
+	 */
+	template<typename FuncType>
+	void ForEachDataByTagADAM(FName Tag, FuncType&& Func) const
+	{
+		if (const TSet<int32>* TagBucket = DataADAM.FindTagBucket(Tag))
+		{
+			for (int32 Slot : *TagBucket)
+			{
+				Func(MakeResidencyViewADAM(Slot));
+			}
+		}
+	}
+
+	// Returns the generation of the data of the tag. See the Blueprint version.
+	int32 GetTagGenerationADAM(FName Tag) const { return DataADAM.GetTagGeneration(Tag); }
+
+	/**
+	 * Returns the latest snapshot of the resident data. Can be called from any thread, never blocks.
+	 * The snapshot and its objects stay valid while the reference is held. Release it before the game instance shuts down.
+	 * The reference is empty if the "Residency snapshot" setting is disabled.
+	 */
+	FResidencySnapshotRefADAM AcquireResidencySnapshotADAM() const;
+
+	// Returns the publication point of the residency snapshots. Worker tasks can capture it on the game thread and acquire snapshots without the subsystem.
+	TSharedPtr<FResidencySnapshotChannelADAM, ESPMode::ThreadSafe> GetResidencySnapshotChannelADAM() const { return ResidencySnapshotChannelADAM; }
+
+	// Checks whether the callbacks of the native request are still expected.
+	bool IsNativeRequestPendingADAM(int32 RequestId) const { return NativeRequestsADAM.Contains(RequestId); }
+
+	// Drop the callbacks of the native request. Data that is being loaded continues loading for the tag of the request.
+	void CancelNativeRequestADAM(int32 RequestId) { NativeRequestsADAM.Remove(RequestId); }
+
+	/**
+	 * Collects the Primary Data Assets referenced directly by the Data Asset, with the same search as the recursive loading.
+	 * Used by the editor tools to build the nested manifest.
+	 * 
+	 * @param PrimaryDataAsset Loaded data asset to inspect.
+	 * @param OutNestedAssets Array to collect discovered nested PrimaryDataAssets, without duplicates.
+	 */
+	static void FindNestedAssetsADAM(const UPrimaryDataAsset* PrimaryDataAsset, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& OutNestedAssets);
+
+#pragma endregion NATIVE_FUNCTIONS
+
+protected:
+	// Checks whether the data asset is stored and owned by the tag.
+	bool IsOwnedByTagADAM(const FSoftObjectPath& AssetPath, FName Tag) const;
+
+	// Determines the type of string and returns it in FName. If all variables contain an empty string, returns NAME_None.
+	UFUNCTION()
+	FName GetTagNameFromStruct(FTagADAM& Tag);
+
+private:
+	UPROPERTY()
+	bool EnableLog = false;
+
+	UPROPERTY()
+	bool BatchArrayLoading = false;
+
+	UPROPERTY()
+	int32 RecursivePriorityDecay = 0;
+
+	UPROPERTY()
+	float PostLoadFrameBudget = 0.0f;
+
+	UPROPERTY()
+	bool PerAssetLoadEvent = true;
+
+	UPROPERTY()
+	ENestedDiscoveryADAM NestedDiscovery = ENestedDiscoveryADAM::Reflection;
+
+	// Memory budget in bytes. '0' if the budget is not limited.
+	int64 MemoryBudget = 0;
+
+	UPROPERTY()
+	int32 MemoryPressureTarget = 0;
+
+	UPROPERTY()
+	EEvictionTierADAM DefaultEvictionTier = EEvictionTierADAM::Never;
+
+	// Eviction tier of each tag. Tags that are not listed use the default tier.
+	UPROPERTY()
+	TMap<FName, EEvictionTierADAM> EvictionTiers;
+
+	FDelegateHandle MemoryTrimHandle;
+
+	UPROPERTY()
+	float DefaultGracePeriod = 0.0f;
+
+	// Grace period of each tag in seconds. Tags that are not listed use the default grace period.
+	UPROPERTY()
+	TMap<FName, float> GracePeriods;
+
+	// Unloaded data assets waiting for their grace period to expire (asset path -> kept descriptor).
+	TMap<FSoftObjectPath, FCoolingADAM> CoolingADAM;
+
+	// Sum of the resident sizes of the cooling pool in bytes.
+	int64 CoolingResidentSize = 0;
+
+	// Requests of the native C++ API waiting for their callbacks (request ID -> callbacks).
+	TMap<int32, FNativeRequestADAM> NativeRequestsADAM;
+
+	// Source of unique native request IDs.
+	int32 NativeRequestCounterADAM = 0;
+
+	UPROPERTY()
+	bool PredictivePrefetch = false;
+
+	UPROPERTY()
+	float PrefetchThreshold = 0.5f;
+
+	UPROPERTY()
+	int32 PrefetchPriority = -100;
+
+	UPROPERTY()
+	float PrefetchLifetime = 30.0f;
+
+	UPROPERTY()
+	int32 PrefetchAssetsPerTag = 64;
+
+	// Load sequence model. Loaded on initialization and saved on deinitialization if the predictive prefetch is enabled.
+	FPrefetchModelADAM PrefetchModelADAM;
+
+	// Prefetched data waiting for a request (asset path -> kept descriptor).
+	TMap<FSoftObjectPath, FPrefetchADAM> PrefetchesADAM;
+
+	// Tag whose data is prefetched.
+	FName PredictedTag;
+
+	FPrefetchStatsADAM PrefetchStats;
+
+	// Recorded loads and unloads of the session.
+	FLoadTraceADAM LoadTraceADAM;
+
+	bool IsLoadTraceRecording = false;
+
+	UPROPERTY()
+	bool ResidencySnapshot = false;
+
+	// Created on initialization if the residency snapshot is enabled. Kept until the subsystem is destroyed, so readers never see it change.
+	TSharedPtr<FResidencySnapshotChannelADAM, ESPMode::ThreadSafe> ResidencySnapshotChannelADAM;
+
+	FPublishedSnapshotADAM PublishedSnapshotADAM;
+
+	// Replaced snapshots that can still be held by readers.
+	TArray<FPublishedSnapshotADAM> RetiredSnapshotsADAM;
+
+	FTSTicker::FDelegateHandle SnapshotTickerHandle;
+
+	// Bundle state of the stored Primary Assets (asset path -> requested bundles).
+	TMap<FSoftObjectPath, FPrimaryBundlesADAM> PrimaryBundlesADAM;
+
+	// Nested dependency manifest. Loaded on initialization if the "Manifest" nested discovery is used.
+	FNestedManifestADAM NestedManifestADAM;
+
+	// Classes of Primary Data Assets known to the Asset Registry. Collected on initialization if the "Asset Registry" nested discovery is used.
+	TSet<FTopLevelAssetPath> PrimaryDataAssetClassPaths;
+
+	// Completed loads waiting for post-load processing. Drained every frame within the time budget.
+	UPROPERTY()
+	TArray<FPostLoadADAM> PostLoadQueueADAM;
+
+	// Index of the first unprocessed load of the post-load queue.
+	int32 PostLoadQueueHead = 0;
+
+	// The in-flight table has changed since QueueADAM was rebuilt.
+	bool IsQueueChanged = false;
+
+	FTSTicker::FDelegateHandle PostLoadTickerHandle;
+
+	// Array loads in progress (batch ID -> pending data). Each array load is completed separately, even if several of them share a tag.
+	TMap<int32, FLoadBatchADAM> LoadBatchesADAM;
+
+	// Source of unique array load IDs.
+	int32 LoadBatchCounterADAM = 0;
+
+	// Depth of the unloads in progress. Completion notifications are deferred while it is not zero.
+	int32 UnloadDepthADAM = 0;
+
+	// Notifications of array loads and native requests completed during an unload. Sent when the outermost unload ends, so listeners can't reuse the slots the unload still visits.
+	TArray<TFunction<void()>> DeferredNotificationsADAM;
+
+	// Array loads of the startup preload that are still in progress.
+	TSet<int32> PreloadBatchIdsADAM;
+
+	bool IsPreloaded = false;
+
+	// Loads in progress (asset path -> shared request). Repeated requests are attached instead of being issued again.
+	TMap<FSoftObjectPath, FInFlightADAM> InFlightADAM;
+
+	// Descriptors of batched array loads that are still in progress (batch key -> descriptor).
+	TMap<int32, TSharedPtr<FStreamableHandle>> BatchHandlesADAM;
+
+	// Descriptors of completed batches shared by their entries (descriptor -> number of entries still holding it).
+	TMap<const FStreamableHandle*, int32> SharedHandlesADAM;
+
+	// Source of unique batch keys.
+	int32 BatchCounterADAM = 0;
+
+	// Searching nested data assets
+	UFUNCTION()
+	TArray<TSoftObjectPtr<UPrimaryDataAsset>> FindNestedAssets(UPrimaryDataAsset* DataAsset);
+
+	/**
+	 * Recursive function for searching nested data assets.
+	 * 
+	 * @param Container Pointer to the memory of the struct or object instance being inspected.
+	 * @param Struct Reflection metadata describing the type of the container (UStruct or UClass).
+	 * @param OutNestedAssets Array to collect discovered nested PrimaryDataAssets.
+	 * @param UniqueAssetPaths Set of asset paths used to prevent duplicates when collecting assets.
+	 * 
+	 * Uses the cached reflection plan of the type (soft references, structs, arrays, sets, maps and optionals).
+	 * Only reads the inspected memory, so it can be called from any thread while the container is kept alive.
+	 */
+	static void FindNestedAssetsRecursive(const void* Container, const UStruct* Struct, TArray<TSoftObjectPtr<UPrimaryDataAsset>>& OutNestedAssets, TSet<FSoftObjectPath>& UniqueAssetPaths);
+
+	/**
+	 * Single asynchronous loading with completion notification
+	 * 
+	 * @param PrimaryDataAsset Soft link to data asset.
+	 * @param Tag Designed for data grouping.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority of the request.
+	 * @param BatchId Array load the request belongs to.
+	 */
+	UFUNCTION()
+	void AddToADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId = 0);
+
+	/**
+	 * Multiple asynchronous loading with completion notification
+	 * 
+	 * Unlike the AddToADAM() function, a Data Asset that the tag already owns is not rejected,
+	 * the array load waits for it as well. If the Data Asset is already
+	 * being loaded or is loaded, no new request is issued.
+	 * 
+	 * @param PrimaryDataAsset Soft link to data asset.
+	 * @param Tag Designed for data grouping.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority of the request.
+	 * @param BatchId Array load the request belongs to.
+	 */
+	UFUNCTION()
+	void AddAllToADAM(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId = 0);
+
+	/**
+	 * Batched asynchronous loading of an array with a single request to the StreamableManager.
+	 * Each Data Asset gets its own entry in the ADAM storage right away, its own descriptor is assigned after the batch is loaded.
+	 * 
+	 * @param PrimaryDataAssets Soft links to data assets.
+	 * @param Tag Designed for data grouping.
+	 * @param NotifyAfterFullLoaded If true, Data Assets the tag already owns are not rejected and the "OnAllLoaded" event is used for notification.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority of the request.
+	 * @param BatchId Array load the request belongs to.
+	 * @param NumClosureRoots If set, the array is a known nested closure. Its first data assets are the roots, they report RecursiveDepthLoading, the rest report '0'. No nested data search is made.
+	 */
+	void AddBatchToADAM(const TArray<TSoftObjectPtr<UPrimaryDataAsset>>& PrimaryDataAssets, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId = 0, int32 NumClosureRoots = INDEX_NONE);
+
+	/**
+	 * Delegate notification of the StreamableManager. Adds the completed load to the post-load queue.
+	 * 
+	 * @param PrimaryDataAsset Soft link to data asset.
+	 * @param Tag Designed for data grouping.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority of the request.
+	 * @param NotifyAfterFullLoaded If true, the load is processed by OnAllLoaded, otherwise by OnLoaded.
+	 * @param RequestId Native request to report the load to. If set to '0', the load is reported by the subsystem delegates.
+	 * @param BatchId Array load the Data Asset belongs to.
+	 * @param IsNestedRequested If true, the nested data was requested together with the Data Asset and is not searched.
+	 */
+	UFUNCTION()
+	void OnStreamableLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, bool NotifyAfterFullLoaded, int32 RequestId = 0, int32 BatchId = 0, bool IsNestedRequested = false);
+
+	/**
+	 * Processing of the post-load queue within the time budget of the frame.
+	 * All Data Assets processed during the frame are reported by a single OnFrameLoadedADAM notification.
+	 */
+	bool TickPostLoad(float DeltaTime);
+
+	// Update the storage counters of the ADAM stats group.
+	void UpdateStatsADAM();
+
+	// Publish a new residency snapshot if the stored data has changed and reclaim the snapshots released by all readers. Ticks after the post-load processing.
+	bool TickResidencySnapshotADAM(float DeltaTime);
+
+	// Build a snapshot of the loaded data and replace the published one.
+	void PublishResidencySnapshotADAM();
+
+	// Free the replaced snapshots that no reader holds anymore.
+	void ReclaimResidencySnapshotsADAM();
+
+	/**
+	* Delegate notification after loading Data Asset into ADAM subsystem
+	* 
+	* @param PrimaryDataAsset Soft link to data asset.
+	* @param Tag Designed for data grouping.
+	* @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	* @param Priority Loading priority of the request. Nested data assets inherit it.
+	* @param BatchId Array load of the data asset. Nested data assets are added to it.
+	* @param IsNestedRequested If true, the nested data was requested together with the data asset and is not searched.
+	* 
+	* PrimaryDataAsset - a soft link with a generic suffix.
+	* Tag - a given tag for grouping data.
+	* RecursiveDepthLoading - whether the recursive option was selected during loading.
+	*/
+	UFUNCTION()
+	void OnLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId = 0, bool IsNestedRequested = false);
+
+	/**
+	 * Delegate notification after full loading Data Asset into ADAM subsystem
+	 * 
+	 * @param PrimaryDataAsset Soft link to data asset.
+	 * @param Tag Designed for data grouping.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority of the request. Nested data assets inherit it.
+	 * @param BatchId Array load of the data asset. Nested data assets are added to it.
+	 * @param IsNestedRequested If true, the nested data was requested together with the data asset and is not searched.
+	 * 
+	 * PrimaryDataAsset - a soft link with a generic suffix.
+	 * Tag - a given tag for grouping data.
+	 * RecursiveDepthLoading - whether the recursive option was selected during loading.
+	 */
+	UFUNCTION()
+	void OnAllLoaded(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId = 0, bool IsNestedRequested = false);
+
+	/**
+	 * Delegate notification after loading a batch of Data Assets into ADAM subsystem
+	 * 
+	 * @param BatchKey Key of the batch descriptor.
+	 * @param BatchPaths Paths of the data assets requested by the batch.
+	 */
+	UFUNCTION()
+	void OnBatchLoaded(int32 BatchKey, TArray<FSoftObjectPath> BatchPaths);
+
+	/**
+	 * Issue a new request and register it in the in-flight table.
+	 * 
+	 * @param AssetPath Path of the data asset.
+	 * @param Requester The first requester of the load.
+	 * @return False if there is nothing to load. The entry of the requester is removed in this case.
+	 */
+	bool RequestInFlightADAM(const FSoftObjectPath& AssetPath, const FInFlightRequesterADAM& Requester);
+
+	/**
+	 * Attach the requester to the load in progress. No new request is issued.
+	 * 
+	 * @param AssetPath Path of the data asset.
+	 * @param Requester Requester waiting for the load.
+	 * @return False if the data asset is not being loaded.
+	 */
+	bool AttachInFlightADAM(const FSoftObjectPath& AssetPath, const FInFlightRequesterADAM& Requester);
+
+	/**
+	 * Load a Data Asset for the requester. A Data Asset that is already stored is shared: the tag of the requester is added to its owners
+	 * and no new request is issued.
+	 * 
+	 * @param AssetPath Path of the data asset.
+	 * @param Requester Requester of the load.
+	 * @return False if nothing is expected to be loaded for the requester.
+	 */
+	bool AddRequesterADAM(const FSoftObjectPath& AssetPath, const FInFlightRequesterADAM& Requester);
+
+	// Detach the requesters of the tag from the load in progress. The request itself continues for the other owners.
+	void DetachInFlightADAM(const FSoftObjectPath& AssetPath, FName Tag);
+
+	// Release the descriptors of batches whose Data Assets are no longer being loaded.
+	void ReleaseIdleBatchHandlesADAM(const TSet<int32>& BatchKeys);
+
+	// Cancel the load in progress together with the notifications of all requesters.
+	void CancelInFlightADAM(const FSoftObjectPath& AssetPath);
+
+	// Delegate notification of the StreamableManager for a request of the in-flight table.
+	void OnInFlightLoaded(FSoftObjectPath AssetPath);
+
+	/**
+	 * Hand the loaded data asset over to its entry and notify all requesters.
+	 * 
+	 * @param AssetPath Path of the data asset.
+	 * @param BatchHandle Descriptor of the completed batch. The entry shares it instead of getting its own one.
+	 */
+	void CompleteInFlightADAM(const FSoftObjectPath& AssetPath, const TSharedPtr<FStreamableHandle>& BatchHandle = nullptr);
+
+	// Release the descriptor of an entry. A shared batch descriptor is released together with its last entry.
+	void ReleaseStreamableHandleADAM(const TSharedPtr<FStreamableHandle>& StreamableHandle);
+
+	// Data asset held by the descriptor. A shared batch descriptor holds several assets, so the asset is resolved by its path.
+	UObject* GetStreamableAssetADAM(const TSharedPtr<FStreamableHandle>& StreamableHandle, const FSoftObjectPath& AssetPath) const;
+
+	// Start tracking a new array load. Returns its ID.
+	int32 CreateLoadBatchADAM(FName Tag, bool NotifyAfterFullLoaded);
+
+	/**
+	 * Requests the Data Assets of an array load. Data Assets with a known nested closure are requested together with their nested data.
+	 * 
+	 * @param PrimaryDataAssets Soft links to data assets.
+	 * @param Tag Designed for data grouping.
+	 * @param NotifyAfterFullLoaded If true, the "OnAllLoaded" event is broadcast after the array load is complete.
+	 * @param RecursiveDepthLoading Recursion support and depth.
+	 * @param Priority Loading priority of the requests.
+	 * @param BatchId Array load the requests belong to.
+	 * @param SingleRequest If true, the array is sent to the StreamableManager as a single request regardless of the "Batch array loading" setting.
+	 */
+	void RequestArrayADAM(TArray<TSoftObjectPtr<UPrimaryDataAsset>> PrimaryDataAssets, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId, bool SingleRequest);
+
+	// Requests the startup preload from the plugin settings.
+	void PreloadADAM(const TArray<FPreloadADAM>& PreloadEntries, int32 Priority);
+
+	// Completes the array load of the startup preload. The "OnPreloadedADAM" event is broadcast after the last one.
+	void CompletePreloadBatchADAM(int32 BatchId);
+
+	// Add the Data Asset to the pending data of the array load.
+	void AddToLoadBatchADAM(int32 BatchId, const FSoftObjectPath& AssetPath);
+
+	// Mark the Data Asset of the array load as processed and notify when all data of the array load has been loaded.
+	void ResolveLoadBatchADAM(int32 BatchId, const FSoftObjectPath& AssetPath);
+
+	// Notify about the completed array load and stop tracking it.
+	void TryCompleteLoadBatchADAM(int32 BatchId);
+
+	// Broadcast the completion of the array load.
+	void NotifyLoadBatchADAM(int32 BatchId, FName Tag, bool NotifyAfterFullLoaded, bool HasData);
+
+	// Start an unload. Completion notifications are deferred until the matching "EndUnloadADAM".
+	void BeginUnloadADAM();
+
+	// End an unload and send the deferred completion notifications when it is the outermost one.
+	void EndUnloadADAM();
+
+	/**
+	 * Remove Data Asset from the ADAM storage and asynchronously unload it.
+	 * Other entries keep their slot indexes.
+	 * 
+	 * @param ForcedUnload If false, the function call will stop loading the Data Asset
+	 */
+	UFUNCTION()
+	void RemoveFromADAM(int32 DataAssetIndex, bool ForcedUnload);
+
+	/**
+	 * Searching nested data assets on a worker thread. The result is passed to RecursiveLoad on the game thread.
+	 * 
+	 * @param PrimaryDataAsset Soft link to the loaded data asset.
+	 * @param Tag Designed for data grouping.
+	 * @param NotifyAfterFullLoaded If true, the "OnAllLoaded" event will notify you when all data in the array has been fully loaded. Data Assets that are already stored are shared with the tag and are also included in the notification.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority of the parent. Nested data assets inherit it, decreased by the "Recursive priority decay" setting.
+	 * @param BatchId Array load of the parent. The nested data assets are added to it.
+	 */
+	void FindNestedAssetsAsync(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId = 0);
+
+	/**
+	 * Asynchronous loading of the nested Data Assets found for the parent
+	 * 
+	 * @param PrimaryDataAsset Soft link to the parent data asset.
+	 * @param NestedAssets Nested data assets found in the parent.
+	 * @param Tag Designed for data grouping.
+	 * @param NotifyAfterFullLoaded If true, the "OnAllLoaded" event will notify you when all data in the array has been fully loaded. Data Assets that are already stored are shared with the tag and are also included in the notification.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority of the parent. Nested data assets inherit it, decreased by the "Recursive priority decay" setting.
+	 * @param BatchId Array load of the parent. The nested data assets are added to it.
+	 */
+	UFUNCTION()
+	void RecursiveLoad(TSoftObjectPtr<UPrimaryDataAsset> PrimaryDataAsset, const TArray<TSoftObjectPtr<UPrimaryDataAsset>>& NestedAssets, FName Tag, bool NotifyAfterFullLoaded, int32 RecursiveDepthLoading, int32 Priority, int32 BatchId = 0);
+
+	/**
+	 * Collects the known closure of nested Data Assets according to the nested discovery setting.
+	 * 
+	 * @param AssetPath Path of the parent data asset.
+	 * @param RecursiveDepthLoading Maximum depth. If set to '-1', the whole closure is collected.
+	 * @param OutClosure Paths of the nested data assets.
+	 * @return False if the closure is unknown and the nested data has to be searched after the parent is loaded.
+	 */
+	bool GetNestedClosureADAM(const FSoftObjectPath& AssetPath, int32 RecursiveDepthLoading, TArray<FSoftObjectPath>& OutClosure) const;
+
+	/**
+	 * Collects the closure of nested Data Assets from the soft package dependencies of the Asset Registry.
+	 * Packages are visited once, so circular references are not followed twice.
+	 * 
+	 * @param AssetPath Path of the parent data asset.
+	 * @param RecursiveDepthLoading Maximum depth. If set to '-1', the whole closure is collected.
+	 * @param OutClosure Paths of the nested data assets, ordered by depth.
+	 * @return False if no nested data is known to the Asset Registry.
+	 */
+	bool GetRegistryClosureADAM(const FSoftObjectPath& AssetPath, int32 RecursiveDepthLoading, TArray<FSoftObjectPath>& OutClosure) const;
+
+	// Raise the loading priority of the entry if it is still being loaded. Only the packages already queued in the package loader are raised.
+	void ReprioritizeSlotADAM(int32 DataAssetIndex, int32 Priority);
+
+	// Mark the entry as used and measure its resident size once the data asset is in memory.
+	void UpdateResidencyADAM(int32 DataAssetIndex);
+
+	// Returns the eviction tier of the entry. Shared data uses the highest tier of its owners.
+	EEvictionTierADAM GetEvictionTierADAM(int32 DataAssetIndex) const;
+
+	/**
+	 * Unload the least recently used data of the evictable tiers, lower tiers first, until the resident size fits the target.
+	 * Data that is still being loaded is not evicted.
+	 * 
+	 * @param TargetResidentSize Resident size to reach in bytes.
+	 * @return Number of evicted data assets.
+	 */
+	int32 EvictADAM(int64 TargetResidentSize);
+
+	// Evict data if the resident size exceeds the memory budget.
+	void EnforceMemoryBudgetADAM();
+
+	// Memory trim notification of the engine. Also called by SimulateMemoryPressureADAM.
+	void OnMemoryPressureADAM();
+
+	// Returns the longest grace period of the tags in seconds.
+	float GetGracePeriodADAM(const TArray<FName>& Tags) const;
+
+	/**
+	 * Move the loaded Data Asset from the ADAM storage to the cooling pool instead of unloading it.
+	 * 
+	 * @param DataAssetIndex Slot of the entry.
+	 * @param GracePeriod Time in seconds the Data Asset is kept in memory.
+	 * @return False if the Data Asset can't be kept. The entry is not changed in this case.
+	 */
+	bool CoolFromADAM(int32 DataAssetIndex, float GracePeriod);
+
+	/**
+	 * Serve the request from the cooling pool. The Data Asset gets its entry back with the kept descriptor and no new request is issued.
+	 * 
+	 * @param AssetPath Path of the data asset.
+	 * @param Requester Requester of the load.
+	 * @return False if the Data Asset is not in the cooling pool.
+	 */
+	bool RestoreFromCoolingADAM(const FSoftObjectPath& AssetPath, const FInFlightRequesterADAM& Requester);
+
+	// Release the descriptor kept by the cooling pool, so the Data Asset can be freed.
+	void ReleaseCoolingADAM(const FSoftObjectPath& AssetPath);
+
+	// Release the data of the cooling pool whose grace period has expired.
+	void TickCoolingADAM();
+
+	/**
+	 * Release the data of the cooling pool that expires first until the resident size fits the target.
+	 * 
+	 * @param TargetResidentSize Resident size to reach in bytes, including the stored data.
+	 */
+	void EvictCoolingADAM(int64 TargetResidentSize);
+
+	/**
+	 * Issue a request of the native C++ API. Data Assets are loaded and shared as with the Blueprint API.
+	 * 
+	 * @param AssetPaths Paths of the data assets.
+	 * @param Tag Designed for data grouping.
+	 * @param RecursiveDepthLoading Recursion support and depth. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite.
+	 * @param Priority Loading priority of the request.
+	 * @param OnLoaded Called for each requested data asset.
+	 * @param OnCompleted Called once after all requested data assets are reported.
+	 * @return ID of the request.
+	 */
+	int32 RequestNativeADAM(const TArray<FSoftObjectPath>& AssetPaths, FName Tag, int32 RecursiveDepthLoading, int32 Priority, TFunction<void(UPrimaryDataAsset*)>&& OnLoaded, TFunction<void()>&& OnCompleted);
+
+	// Post-load processing of a Data Asset of a native request. Calls the callback of the request instead of the subsystem delegates.
+	void OnNativeLoaded(const FPostLoadADAM& PostLoad);
+
+	// Count the Data Asset of the native request as reported and complete the request after the last one.
+	void ReleaseNativeRequesterADAM(int32 RequestId);
+
+	/**
+	 * Register the bundles of a Primary Asset. They are requested together with the Primary Asset if it is not stored yet.
+	 * 
+	 * @param PrimaryAssetId Primary Asset ID.
+	 * @param AssetPath Path of the Primary Asset.
+	 * @param Bundles Requested bundles.
+	 * @return Bundles that were not registered before.
+	 */
+	TArray<FName> AddPrimaryBundlesADAM(const FPrimaryAssetId& PrimaryAssetId, const FSoftObjectPath& AssetPath, const TArray<FName>& Bundles);
+
+	/**
+	 * Request bundles of a Primary Asset that is already stored or requested without the Asset Manager.
+	 * 
+	 * @param PrimaryAssetId Primary Asset ID.
+	 * @param AddBundles Bundles to load.
+	 * @param RemoveBundles Bundles to release.
+	 * @param Priority Loading priority of the request.
+	 */
+	void RequestBundleStateADAM(const FPrimaryAssetId& PrimaryAssetId, const TArray<FName>& AddBundles, const TArray<FName>& RemoveBundles, int32 Priority);
+
+	/**
+	 * Record the load in the prefetch model and prefetch the data of the likely next tag.
+	 * 
+	 * @param Tag Tag of the load.
+	 * @param AssetPaths Requested data assets.
+	 */
+	void RecordLoadADAM(FName Tag, const TArray<FSoftObjectPath>& AssetPaths);
+
+	// Hand the prefetched Data Asset over to a request. Called after the request holds the Data Asset itself.
+	void ConsumePrefetchADAM(const FSoftObjectPath& AssetPath);
+
+	// Release the prefetched Data Asset that was not requested.
+	void ReleasePrefetchADAM(const FSoftObjectPath& AssetPath);
+
+	// Release the prefetched data whose lifetime has expired.
+	void TickPrefetchADAM();
+
+	// Returns the path of the prefetch model file.
+	static FString GetPrefetchModelFileADAM();
+
+	/**
+	 * Add the call to the load trace. Callers check "IsLoadTraceRecording" first, so the arguments are not built while nothing is recorded.
+	 * 
+	 * @param Type Recorded call.
+	 * @param AssetPaths Requested data assets.
+	 * @param Tags Tag of a load or tags of an unload.
+	 * @param RecursiveDepthLoading Recursion depth of a load.
+	 * @param Priority Loading priority of a load.
+	 * @param Flag NotifyAfterFullLoaded of an array load or ForcedUnload of an unload.
+	 */
+	void RecordTraceADAM(ELoadTraceEventADAM Type, const TArray<FSoftObjectPath>& AssetPaths, const TArray<FName>& Tags, int32 RecursiveDepthLoading = 0, int32 Priority = 0, bool Flag = false);
+
+	// Returns the default path of the load trace file.
+	static FString GetLoadTraceFileADAM();
+
+	// Returns the tag names of the container, including the child gameplay tags if requested. Returns NAME_None if the container is empty.
+	TArray<FName> GetTagNamesFromContainerADAM(const FTagContainerADAM& Tag);
+
+	// Release the bundles of the Primary Asset held by the Asset Manager. Called when the Data Asset leaves the subsystem.
+	void ReleasePrimaryBundlesADAM(const FSoftObjectPath& AssetPath);
+
+	FResidencyViewADAM MakeResidencyViewADAM(int32 Slot) const
+	{
+		return FResidencyViewADAM{ DataADAM.GetHandle(Slot), DataADAM.GetAssetPath(Slot), DataADAM.GetOwners(Slot), DataADAM.GetLoadedAsset(Slot), DataADAM.GetResidentSize(Slot) };
+	}
+
+	// Typed callbacks receive the loaded Data Asset cast to the requested class. The path of a soft pointer can resolve to an asset of another class, in that case the callback receives nullptr.
+	template<typename T>
+	static TFunction<void(UPrimaryDataAsset*)> WrapNativeCallbackADAM(TFunction<void(T*)>&& OnLoaded)
+	{
+		if (!OnLoaded)
+			return nullptr;
+
+		return [OnLoaded = MoveTemp(OnLoaded)](UPrimaryDataAsset* LoadedObject)
+		{
+			T* TypedObject = Cast<T>(LoadedObject);
+
+			if (LoadedObject && !TypedObject)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ADAM (Native Load): Data Asset \"%s\" of class \"%s\" is not a \"%s\"."), *LoadedObject->GetName(), *LoadedObject->GetClass()->GetName(), *T::StaticClass()->GetName());
+			}
+
+			OnLoaded(TypedObject);
+		};
+	}
+};
+
+template<typename T>
+bool TRequestADAM<T>::IsPending() const
+{
+	UAsyncDataAssetManagerSubsystem* SubsystemPtr = Subsystem.Get();
+
+	return SubsystemPtr && SubsystemPtr->IsNativeRequestPendingADAM(RequestId);
+}
+
+template<typename T>
+void TRequestADAM<T>::Cancel()
+{
+	if (UAsyncDataAssetManagerSubsystem* SubsystemPtr = Subsystem.Get())
+	{
+		SubsystemPtr->CancelNativeRequestADAM(RequestId);
+	}
+}
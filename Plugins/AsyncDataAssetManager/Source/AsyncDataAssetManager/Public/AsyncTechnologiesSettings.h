@@ -4,8 +4,46 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DeveloperSettings.h"
+#include "Engine/StreamableManager.h"
 #include "AsyncTechnologiesSettings.generated.h"
 
+class UPrimaryDataAsset;
+
+// Source of the nested Data Assets for recursive loading.
+UENUM()
+enum class ENestedDiscoveryADAM : uint8
+{
+	Reflection UMETA(ToolTip = "Nested Data Assets are searched in the properties of each loaded Data Asset. Each level of depth is requested after the previous one is loaded."),
+	Manifest UMETA(ToolTip = "Nested Data Assets are taken from the manifest generated by the NestedManifestADAM commandlet. The whole closure is requested at once. Data Assets missing from the manifest are searched by reflection. Nested data added after the generation is not loaded until the manifest is regenerated, the editor searches the Data Assets changed since then."),
+	AssetRegistry UMETA(ToolTip = "Nested Data Assets are taken from the soft package dependencies of the Asset Registry before loading. The whole closure is requested at once. Packaged builds must keep the dependency data of the Asset Registry, otherwise nested data is searched by reflection.")
+};
+
+// Eviction tier of the data owned by a tag. When memory has to be freed, lower tiers are evicted first.
+UENUM(BlueprintType)
+enum class EEvictionTierADAM : uint8
+{
+	Low UMETA(ToolTip = "Evicted first."),
+	Normal UMETA(ToolTip = "Evicted after all data of the low tier."),
+	High UMETA(ToolTip = "Evicted only if nothing else can be freed."),
+	Never UMETA(ToolTip = "Never evicted automatically. Data stays in memory until it is unloaded explicitly.")
+};
+
+// Data Assets of a tag that are loaded on the start of the game instance.
+USTRUCT()
+struct FPreloadADAM
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "ADAM Subsystem", meta = (ToolTip = "Owner of the preloaded data. Gameplay tags are specified by their full name."))
+	FName Tag;
+
+	UPROPERTY(EditAnywhere, Category = "ADAM Subsystem", meta = (ToolTip = "Data Assets requested together with a single request."))
+	TArray<TSoftObjectPtr<UPrimaryDataAsset>> DataAssets;
+
+	UPROPERTY(EditAnywhere, Category = "ADAM Subsystem", meta = (ClampMin = "-1", ToolTip = "Recursion depth of the preload. If the value is set to '0', recursion will be disabled. If set to '-1', recursion will be infinite."))
+	int32 RecursiveDepthLoading = 0;
+};
+
 /**
  * Async Plugin Technologies Settings
  */
@@ -19,4 +57,67 @@ public:
 
 	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Enable log", ToolTip = "Enables logging for the ADAM subsystem, which notifies about the asynchronous loading and unloading of Data Assets from memory."))
 	bool bEnableLogADAM = false;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Batch array loading", ToolTip = "If true, LoadArrayADAM sends the whole deduplicated array to the StreamableManager as a single request, so the packages are scheduled together. Each Data Asset is still stored separately and can be unloaded individually, but the entries of a batch share its request: the StreamableManager keeps the whole batch referenced until the last of its Data Assets is unloaded."))
+	bool bBatchArrayLoadingADAM = false;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Recursive priority decay", ClampMin = "0", ToolTip = "Nested Data Assets found during recursive loading inherit the loading priority of their parent, decreased by this value for each level of depth. If the value is set to '0', the priority is inherited unchanged."))
+	int32 RecursivePriorityDecayADAM = 0;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Post-load frame budget (ms)", ClampMin = "0.0", ToolTip = "Time per frame spent on processing completed loads (nested data search, notifications). The rest is deferred to the next frame. If the value is set to '0', all completed loads are processed in the same frame."))
+	float PostLoadFrameBudgetADAM = 0.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Per-asset load event", ToolTip = "Broadcasts OnLoadedADAM for each loaded Data Asset in addition to OnFrameLoadedADAM. Each broadcast is a reflective call, so a burst of loads costs one call per Data Asset. Projects that only bind OnFrameLoadedADAM can disable it."))
+	bool bPerAssetLoadEventADAM = true;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Nested discovery", ToolTip = "Source of the nested Data Assets for recursive loading."))
+	ENestedDiscoveryADAM NestedDiscoveryADAM = ENestedDiscoveryADAM::Reflection;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Nested manifest path", EditCondition = "NestedDiscoveryADAM == ENestedDiscoveryADAM::Manifest", ToolTip = "Path of the nested manifest relative to the Content folder of the project. Generate it with \"-run=NestedManifestADAM\" and add its folder to \"Additional Non-Asset Directories to Package\"."))
+	FString NestedManifestPathADAM = TEXT("ADAM/NestedManifestADAM.bin");
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Memory budget (MB)", ClampMin = "0", ToolTip = "Maximum resident size of the stored Data Assets. When it is exceeded, the least recently used data of the evictable tiers is unloaded. If the value is set to '0', the budget is not limited."))
+	int32 MemoryBudgetADAM = 0;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Memory pressure target (%)", ClampMin = "0", ClampMax = "100", ToolTip = "When the engine reports memory pressure, evictable data is unloaded until the resident size drops to this share of the memory budget. Without a budget, the share of the current resident size is used."))
+	int32 MemoryPressureTargetADAM = 50;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Default eviction tier", ToolTip = "Eviction tier of the tags that are not listed in \"Eviction tiers\". Data shared by several tags uses the highest tier of its owners."))
+	EEvictionTierADAM DefaultEvictionTierADAM = EEvictionTierADAM::Never;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Eviction tiers", ToolTip = "Eviction tier of the data owned by each tag. Gameplay tags are specified by their full name."))
+	TMap<FName, EEvictionTierADAM> EvictionTiersADAM;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Default grace period (s)", ClampMin = "0.0", ToolTip = "Time an unloaded Data Asset is kept in the cooling pool for the tags that are not listed in \"Grace periods\". A reload during this time is served from memory without a new request. Forced unloads skip the pool. If the value is set to '0', data is unloaded immediately."))
+	float DefaultGracePeriodADAM = 0.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Grace periods (s)", ToolTip = "Grace period of the data owned by each tag. Data shared by several tags uses the longest grace period of its owners. The cooling pool counts towards the memory budget and is released first when memory has to be freed."))
+	TMap<FName, float> GracePeriodsADAM;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Startup preload", ToolTip = "Data Assets requested as soon as the game instance starts, so they are loaded in parallel with the first map. Each entry is requested with a single request. The \"OnPreloadedADAM\" event notifies when all of them are stored, including their nested data."))
+	TArray<FPreloadADAM> PreloadADAM;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Startup preload priority", ToolTip = "Loading priority of the startup preload. The default value matches the high priority of the StreamableManager."))
+	int32 PreloadPriorityADAM = FStreamableManager::AsyncLoadHighPriority;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Predictive prefetch", ToolTip = "Records the sequence of the tags of LoadADAM and LoadArrayADAM calls and prefetches the data of the likely next tag at a low priority. Prefetched data is not stored under a tag and is released if it is not requested in time. The model is saved to \"Saved/ADAM/PrefetchModelADAM.bin\"."))
+	bool bPredictivePrefetchADAM = false;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Prefetch threshold", ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bPredictivePrefetchADAM", ToolTip = "Minimum share of the observed transitions from the current tag that lead to the next tag for its data to be prefetched."))
+	float PrefetchThresholdADAM = 0.5f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Prefetch priority", EditCondition = "bPredictivePrefetchADAM", ToolTip = "Loading priority of the prefetch. Keep it below the priority of the regular loads, so the prefetch doesn't delay them."))
+	int32 PrefetchPriorityADAM = -100;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Prefetch lifetime (s)", ClampMin = "0.0", EditCondition = "bPredictivePrefetchADAM", ToolTip = "Time prefetched data is kept in memory waiting for a request. Unused data is released and counted as wasted."))
+	float PrefetchLifetimeADAM = 30.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Prefetch assets per tag", ClampMin = "1", EditCondition = "bPredictivePrefetchADAM", ToolTip = "Number of the most recently loaded Data Assets of each tag that are remembered and prefetched."))
+	int32 PrefetchAssetsPerTagADAM = 64;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Record load trace", ToolTip = "Records the loads and unloads of the session from the start of the subsystem. The trace is saved to \"Saved/ADAM/LoadTraceADAM.bin\" on shutdown and can be replayed by the ReplayLoadTraceADAM commandlet. Recording can also be started with the \"ADAM.StartLoadTrace\" console command."))
+	bool bRecordLoadTraceADAM = false;
+
+	UPROPERTY(Config, EditAnywhere, Category = "ADAM Subsystem", meta = (DisplayName = "Residency snapshot", ToolTip = "Publishes an immutable snapshot of the resident data after each frame in which the stored data changed. Worker threads can check whether a Data Asset is resident and get its object without locks. The snapshot is rebuilt from all stored data, so keep it disabled if no worker thread reads it."))
+	bool bResidencySnapshotADAM = false;
 };
@@ -0,0 +1,246 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+#include "DataStorageADAM.generated.h"
+
+// Stable handle of an entry of the ADAM storage. The handle becomes invalid after the entry is removed, even if its slot is reused.
+USTRUCT(BlueprintType)
+struct FHandleADAM
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Slot of the entry in the ADAM storage."))
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "ADAM Subsystem", meta = (ToolTip = "Generation of the slot at the moment the handle was issued."))
+	int32 Generation = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+
+	bool operator==(const FHandleADAM& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FHandleADAM& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FHandleADAM& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+	}
+};
+
+/**
+ * Main storage of the ADAM subsystem.
+ *
+ * A generational slot map with a structure-of-arrays layout. Removed entries free their slot
+ * without moving other entries, so slot indexes and handles stay stable. Asset paths are interned
+ * once and stored per entry as compact integer IDs. Lookup by asset path and by tag is constant time.
+ *
+ * Each asset has a single residency entry. Tags that loaded the asset are stored as its owners,
+ * so the same asset can be shared by several tags. Each entry also tracks its resident size
+ * and the time of the last access for the memory budget of the subsystem.
+ *
+ * Loaded entries are bucketed by the exact class of their asset. Queries by class only visit
+ * the buckets of the matching classes and their results are cached.
+ *
+ * The storage and each tag have a generation counter, so readers can skip their work if nothing has changed.
+ */
+class ASYNCDATAASSETMANAGER_API FDataStorageADAM
+{
+public:
+	/**
+	 * Add a new entry to the storage. If the asset is already stored, the tag is added to the owners of its entry and the descriptor is ignored.
+	 *
+	 * @param AssetPath Path of the data asset.
+	 * @param StreamableHandle Data Asset Descriptor.
+	 * @param Tag Designed for data grouping. Becomes the first owner of the entry.
+	 * @param Priority Loading priority of the request.
+	 * @return Stable handle of the new entry.
+	 */
+	FHandleADAM Add(const FSoftObjectPath& AssetPath, TSharedPtr<FStreamableHandle> StreamableHandle, FName Tag, int32 Priority = 0);
+
+	// Remove the entry of the specified slot together with all of its owners. The slot is reused by the next addition.
+	void RemoveAt(int32 Slot);
+
+	// Add the tag to the owners of the entry. Returns false if the tag already owns it.
+	bool AddOwner(int32 Slot, FName Tag);
+
+	// Remove the tag from the owners of the entry. Returns false if the tag does not own it. The entry is kept even without owners.
+	bool RemoveOwner(int32 Slot, FName Tag);
+
+	bool HasOwner(int32 Slot, FName Tag) const { return Owners[Slot].Contains(Tag); }
+
+	int32 GetNumOwners(int32 Slot) const { return Owners[Slot].Num(); }
+
+	// Returns the tags owning the entry, in the order they were added.
+	const TArray<FName>& GetOwners(int32 Slot) const { return Owners[Slot]; }
+
+	// Remove all entries. Interned asset paths are kept.
+	void Empty();
+
+	// Returns the number of stored entries.
+	int32 Num() const { return NumEntries; }
+
+	bool IsEmpty() const { return NumEntries == 0; }
+
+	// Returns the number of slots including free ones. Upper bound for iteration by slot.
+	int32 GetMaxIndex() const { return Generations.Num(); }
+
+	bool IsValidIndex(int32 Slot) const { return AliveSlots.IsValidIndex(Slot) && AliveSlots[Slot]; }
+
+	bool IsValidHandle(const FHandleADAM& Handle) const { return IsValidIndex(Handle.Index) && Generations[Handle.Index] == Handle.Generation; }
+
+	// Returns the handle of the occupied slot.
+	FHandleADAM GetHandle(int32 Slot) const;
+
+	// Returns the slot of the entry with the specified asset path. If nothing is found returns INDEX_NONE.
+	int32 FindSlot(const FSoftObjectPath& AssetPath) const;
+
+	// Returns the slots of all entries owned by the specified tag.
+	const TSet<int32>* FindTagBucket(FName Tag) const { return TagIndex.Find(Tag); }
+
+	const TMap<FName, TSet<int32>>& GetTagBuckets() const { return TagIndex; }
+
+	// Iterates occupied slots in ascending order.
+	TConstSetBitIterator<> CreateConstIterator() const { return TConstSetBitIterator<>(AliveSlots); }
+
+	const FSoftObjectPath& GetAssetPath(int32 Slot) const { return InternedPaths[PathIds[Slot]]; }
+
+	int32 GetPathId(int32 Slot) const { return PathIds[Slot]; }
+
+	TSharedPtr<FStreamableHandle>& GetStreamableHandle(int32 Slot) { return StreamableHandles[Slot]; }
+
+	const TSharedPtr<FStreamableHandle>& GetStreamableHandle(int32 Slot) const { return StreamableHandles[Slot]; }
+
+	// Returns the first owner of the entry. If the entry has no owners returns NAME_None.
+	FName GetTag(int32 Slot) const { return Owners[Slot].IsEmpty() ? NAME_None : Owners[Slot][0]; }
+
+	int32 GetPriority(int32 Slot) const { return Priorities[Slot]; }
+
+	void SetPriority(int32 Slot, int32 Priority) { Priorities[Slot] = Priority; }
+
+	// Returns the resident size of the entry in bytes. If the size has not been measured yet returns INDEX_NONE.
+	int64 GetResidentSize(int32 Slot) const { return ResidentSizes[Slot]; }
+
+	// Set the measured resident size of the entry. The total resident size of the storage is updated accordingly.
+	void SetResidentSize(int32 Slot, int64 ResidentSize);
+
+	// Returns the sum of the measured resident sizes of all entries in bytes.
+	int64 GetTotalResidentSize() const { return TotalResidentSize; }
+
+	double GetLastAccessTime(int32 Slot) const { return LastAccessTimes[Slot]; }
+
+	// Mark the entry as used at the current time. Least recently used entries are evicted first.
+	void Touch(int32 Slot) { LastAccessTimes[Slot] = FPlatformTime::Seconds(); }
+
+	// Returns the class of the loaded asset of the entry. If the asset has not finished loading returns nullptr.
+	const UClass* GetClass(int32 Slot) const { return Classes[Slot]; }
+
+	// Returns the loaded asset of the entry. If the asset has not finished loading returns nullptr.
+	UObject* GetLoadedAsset(int32 Slot) const { return LoadedAssets[Slot]; }
+
+	/**
+	 * Register the loaded asset of the entry and its class. The asset is resolved once, so getters don't have to go through the streamable handle.
+	 * The class of a resident asset never changes, so it is set once per entry.
+	 *
+	 * @param Slot Slot of the entry.
+	 * @param LoadedAsset Asset kept in memory by the streamable handle of the entry.
+	 */
+	void SetLoadedAsset(int32 Slot, UObject* LoadedAsset);
+
+	// Returns the generation of the storage. It changes whenever an entry is added, removed, finishes loading or changes its owners.
+	int32 GetGeneration() const { return Generation; }
+
+	// Returns the generation of the tag. It changes whenever an entry owned by the tag is added, removed or finishes loading. Returns 0 if the tag has never owned data.
+	int32 GetTagGeneration(FName Tag) const { return TagGenerations.FindRef(Tag); }
+
+	/**
+	 * Find the loaded entries of the class or of its child classes. Only the buckets of the matching classes are visited.
+	 * The result is cached until an entry of a matching class is added, removed or changes its owners.
+	 *
+	 * @param Class Requested class.
+	 * @param Tag Owner of the entries.
+	 * @param bIgnoreTag If true, the entries of all tags are returned.
+	 * @return Slots of the entries in ascending order.
+	 */
+	const TArray<int32>& FindClassSlots(const UClass* Class, FName Tag, bool bIgnoreTag) const;
+
+	// Returns the interned ID of the asset path. If the path is not stored returns INDEX_NONE.
+	int32 FindPathId(const FSoftObjectPath& AssetPath) const;
+
+	const FSoftObjectPath& GetAssetPathById(int32 PathId) const { return InternedPaths[PathId]; }
+
+private:
+	struct FClassQuery
+	{
+		// The queried class can be collected while its cached result is kept
+		TWeakObjectPtr<const UClass> Class;
+
+		// NAME_None if the tag is ignored
+		FName Tag;
+
+		bool bIgnoreTag = false;
+
+		bool operator==(const FClassQuery& Other) const { return Class == Other.Class && Tag == Other.Tag && bIgnoreTag == Other.bIgnoreTag; }
+
+		friend uint32 GetTypeHash(const FClassQuery& Query)
+		{
+			return HashCombine(HashCombine(::GetTypeHash(Query.Class), ::GetTypeHash(Query.Tag)), ::GetTypeHash(Query.bIgnoreTag));
+		}
+	};
+
+	int32 InternPath(const FSoftObjectPath& AssetPath);
+
+	// Free the ID of a removed entry. Each path has a single entry, so the ID is owned by its slot.
+	void ReleasePathId(int32 PathId);
+
+	/**
+	 * Drop the cached queries whose result can include an entry of the class.
+	 *
+	 * @param Class Class of the changed entry.
+	 * @param Tag Changed owner of the entry. Queries of other tags keep their results.
+	 * @param bAllTags If true, the entry itself is added or removed, so the queries of all tags are dropped.
+	 */
+	void InvalidateClassQueries(const UClass* Class, FName Tag, bool bAllTags);
+
+	// Change the generation of the storage and of the tag. The tag receives the new generation of the storage, so its value never repeats.
+	void MarkTagChanged(FName Tag) { TagGenerations.FindOrAdd(Tag) = ++Generation; }
+
+	// Per-slot data. All arrays are indexed by slot.
+	TArray<int32> PathIds;
+	TArray<TSharedPtr<FStreamableHandle>> StreamableHandles;
+	TArray<TArray<FName>> Owners;
+	TArray<int32> Priorities;
+	TArray<int64> ResidentSizes;
+	TArray<double> LastAccessTimes;
+	TArray<const UClass*> Classes;
+	TArray<UObject*> LoadedAssets;
+	TArray<int32> Generations;
+	TBitArray<> AliveSlots;
+
+	// Free slots, reused in LIFO order
+	TArray<int32> FreeSlots;
+	int32 NumEntries = 0;
+	int64 TotalResidentSize = 0;
+	int32 Generation = 0;
+
+	// Interned asset paths of the stored entries (path ID -> path and back). IDs of removed entries are reused.
+	TArray<FSoftObjectPath> InternedPaths;
+	TMap<FSoftObjectPath, int32> PathToId;
+	TArray<int32> FreePathIds;
+
+	// Lookup indexes (path ID -> slot, tag -> slots)
+	TMap<int32, int32> PathIndex;
+	TMap<FName, TSet<int32>> TagIndex;
+
+	// Loaded entries by exact class. The class is kept alive by the loaded asset of the entry.
+	TMap<const UClass*, TSet<int32>> ClassIndex;
+
+	// Results of the class queries (query -> slots)
+	mutable TMap<FClassQuery, TArray<int32>> ClassQueryCache;
+
+	// Generations of the tags, kept after the tag loses its data (tag -> generation)
+	TMap<FName, int32> TagGenerations;
+};
@@ -0,0 +1,100 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Recorded call of the ADAM subsystem.
+enum class ELoadTraceEventADAM : uint8
+{
+	Load,
+	LoadArray,
+	FastLoad,
+	Unload,
+	UnloadAll,
+	UnloadAllTags
+};
+
+struct FLoadTraceEventADAM
+{
+	ELoadTraceEventADAM Type = ELoadTraceEventADAM::Load;
+
+	// Seconds since the start of the recording
+	double Time = 0.0;
+
+	// Requested data assets (path IDs of the trace)
+	TArray<int32> PathIds;
+
+	// Tag of a load or tags of an unload (tag IDs of the trace)
+	TArray<int32> TagIds;
+
+	int32 RecursiveDepthLoading = 0;
+
+	int32 Priority = 0;
+
+	// NotifyAfterFullLoaded of an array load or ForcedUnload of an unload
+	bool Flag = false;
+
+	friend FArchive& operator<<(FArchive& Ar, FLoadTraceEventADAM& Event)
+	{
+		return Ar << Event.Type << Event.Time << Event.PathIds << Event.TagIds << Event.RecursiveDepthLoading << Event.Priority << Event.Flag;
+	}
+};
+
+/**
+ * Load trace of the ADAM subsystem.
+ *
+ * Records the loads and unloads of a session with their tags, recursion depth and timestamps, so the session
+ * can be replayed by the ReplayLoadTraceADAM commandlet. Paths and tags are interned, each event only stores their IDs.
+ */
+class ASYNCDATAASSETMANAGER_API FLoadTraceADAM
+{
+public:
+	// Clears the trace and starts the clock of the recording.
+	void Start();
+
+	/**
+	 * Add an event at the current time of the recording.
+	 *
+	 * @param Type Recorded call.
+	 * @param AssetPaths Requested data assets.
+	 * @param Tags Tag of a load or tags of an unload.
+	 * @return The added event, so the remaining parameters of the call can be set.
+	 */
+	FLoadTraceEventADAM& AddEvent(ELoadTraceEventADAM Type, const TArray<FSoftObjectPath>& AssetPaths, const TArray<FName>& Tags);
+
+	const TArray<FLoadTraceEventADAM>& GetEvents() const { return Events; }
+
+	const FSoftObjectPath& GetPath(int32 PathId) const { return Paths[PathId]; }
+
+	FName GetTag(int32 TagId) const { return Tags[TagId]; }
+
+	// Returns the number of recorded events.
+	int32 Num() const { return Events.Num(); }
+
+	bool IsEmpty() const { return Events.IsEmpty(); }
+
+	void Empty();
+
+	bool LoadFromFile(const FString& FileName);
+
+	bool SaveToFile(const FString& FileName) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FLoadTraceADAM& Trace);
+
+private:
+	int32 InternPath(const FSoftObjectPath& AssetPath);
+
+	int32 InternTag(FName Tag);
+
+	double StartTime = 0.0;
+
+	// Interned asset paths and tags (ID -> value and back). Only the tables are serialized.
+	TArray<FSoftObjectPath> Paths;
+	TMap<FSoftObjectPath, int32> PathToId;
+
+	TArray<FName> Tags;
+	TMap<FName, int32> TagToId;
+
+	TArray<FLoadTraceEventADAM> Events;
+};
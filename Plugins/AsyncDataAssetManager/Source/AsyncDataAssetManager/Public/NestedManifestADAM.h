@@ -0,0 +1,94 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+/**
+ * Nested dependency manifest of the ADAM subsystem.
+ *
+ * For each Primary Data Asset stores the closure of its nested Primary Data Assets with the depth at which
+ * each of them is first reached. The manifest is generated by the NestedManifestADAM commandlet, so recursive
+ * loading can request the whole closure at once instead of waiting for each level to be loaded and searched.
+ *
+ * The closures are not searched again after loading, so nested data added after the manifest was generated is not
+ * loaded until the manifest is regenerated. The saved hash of each package is stored with the manifest, so the
+ * editor can drop the closures of changed Data Assets and fall back to the search for them.
+ */
+class ASYNCDATAASSETMANAGER_API FNestedManifestADAM
+{
+public:
+	/**
+	 * Set the closure of the Data Asset. Replaces the previous closure.
+	 *
+	 * @param AssetPath Path of the root data asset.
+	 * @param Closure Nested data assets of the root and the depth at which each of them is first reached (starting from '1').
+	 */
+	void SetClosure(const FSoftObjectPath& AssetPath, const TArray<TPair<FSoftObjectPath, int32>>& Closure);
+
+	/**
+	 * Collects the nested data assets of the root up to the specified depth.
+	 *
+	 * @param AssetPath Path of the root data asset.
+	 * @param RecursiveDepthLoading Maximum depth. If set to '-1', the whole closure is returned.
+	 * @param OutClosure Paths of the nested data assets, ordered by depth.
+	 * @return False if the manifest does not contain the root.
+	 */
+	bool GetClosure(const FSoftObjectPath& AssetPath, int32 RecursiveDepthLoading, TArray<FSoftObjectPath>& OutClosure) const;
+
+	bool Contains(const FSoftObjectPath& AssetPath) const;
+
+	/**
+	 * Set the saved hash of the package of the Data Asset at the time the manifest is generated.
+	 *
+	 * @param AssetPath Path of the data asset.
+	 * @param SavedHash Saved hash of the package of the data asset.
+	 */
+	void SetSavedHash(const FSoftObjectPath& AssetPath, const FIoHash& SavedHash);
+
+	/**
+	 * Removes the closures that contain a Data Asset whose package has been saved since the manifest was generated.
+	 *
+	 * @param GetSavedHash Returns the current saved hash of the package of the data asset. A zero hash is treated as unknown.
+	 * @return Number of removed closures.
+	 */
+	int32 RemoveStaleClosures(TFunctionRef<FIoHash(const FSoftObjectPath&)> GetSavedHash);
+
+	// Returns the number of roots in the manifest.
+	int32 Num() const { return Closures.Num(); }
+
+	bool IsEmpty() const { return Closures.IsEmpty(); }
+
+	void Empty();
+
+	bool LoadFromFile(const FString& FileName);
+
+	bool SaveToFile(const FString& FileName) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FNestedManifestADAM& Manifest);
+
+private:
+	struct FEntry
+	{
+		int32 PathId = INDEX_NONE;
+		int32 Depth = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FEntry& Entry)
+		{
+			return Ar << Entry.PathId << Entry.Depth;
+		}
+	};
+
+	int32 InternPath(const FSoftObjectPath& AssetPath);
+
+	// Interned asset paths (path ID -> path and back). Only the path table is serialized.
+	TArray<FSoftObjectPath> Paths;
+	TMap<FSoftObjectPath, int32> PathToId;
+
+	// Saved hashes of the packages when the manifest was generated (path ID -> hash). Zero if unknown.
+	TArray<FIoHash> SavedHashes;
+
+	// Closures of the roots (root path ID -> nested entries ordered by depth)
+	TMap<int32, TArray<FEntry>> Closures;
+};
@@ -0,0 +1,59 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Load sequence model of the ADAM subsystem.
+ *
+ * Counts transitions between the tags of consecutive loads (first-order Markov chain) and remembers the
+ * most recently loaded Data Assets of each tag, so the data of the likely next tag can be prefetched.
+ * The model is persisted between sessions.
+ */
+class ASYNCDATAASSETMANAGER_API FPrefetchModelADAM
+{
+public:
+	/**
+	 * Record a load of the tag.
+	 *
+	 * @param Tag Tag of the load.
+	 * @param AssetPaths Requested data assets.
+	 * @param MaxAssetsPerTag Number of the most recently loaded data assets kept for each tag.
+	 * @return True if the tag differs from the tag of the previous load.
+	 */
+	bool RecordLoad(FName Tag, const TArray<FSoftObjectPath>& AssetPaths, int32 MaxAssetsPerTag);
+
+	/**
+	 * Returns the most likely tag loaded after the tag.
+	 *
+	 * @param Tag Tag of the current load.
+	 * @param MinProbability Minimum share of the transitions from the tag that lead to the predicted tag.
+	 * @return NAME_None if no transition is likely enough.
+	 */
+	FName PredictNext(FName Tag, float MinProbability) const;
+
+	// Returns the most recently loaded data assets of the tag, the newest first.
+	const TArray<FSoftObjectPath>* FindAssets(FName Tag) const;
+
+	// Returns the number of tags in the model.
+	int32 Num() const { return TagAssets.Num(); }
+
+	void Empty();
+
+	bool LoadFromFile(const FString& FileName);
+
+	bool SaveToFile(const FString& FileName) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FPrefetchModelADAM& Model);
+
+private:
+	// Tag of the previous load. Not serialized, each session starts without history.
+	FName LastTag;
+
+	// Observed transitions (tag -> next tag -> number of observations)
+	TMap<FName, TMap<FName, int32>> Transitions;
+
+	// Most recently loaded data assets of each tag, the newest first
+	TMap<FName, TArray<FSoftObjectPath>> TagAssets;
+};
@@ -0,0 +1,127 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Casts.h"
+#include "Templates/RefCounting.h"
+#include "UObject/SoftObjectPtr.h"
+
+#include <atomic>
+
+/**
+ * Immutable snapshot of the resident data of the ADAM subsystem.
+ *
+ * Built on the game thread after the stored data changes and never modified after it is published,
+ * so it can be read from any thread without locks. The loaded objects of the snapshot are kept alive
+ * by the subsystem until every reader has released the snapshot.
+ */
+class ASYNCDATAASSETMANAGER_API FResidencySnapshotADAM
+{
+public:
+	struct FEntry
+	{
+		UObject* Object = nullptr;
+
+		const UClass* Class = nullptr;
+
+		// Tags owning the Data Asset, in the order they were added
+		TArray<FName> Owners;
+	};
+
+	FResidencySnapshotADAM(int32 InGeneration, TMap<FSoftObjectPath, FEntry>&& InEntries)
+		: Entries(MoveTemp(InEntries))
+		, Generation(InGeneration)
+	{
+	}
+
+	// Returns the entry of the Data Asset. If the Data Asset is not resident returns nullptr.
+	const FEntry* Find(const FSoftObjectPath& AssetPath) const { return Entries.Find(AssetPath); }
+
+	bool IsResident(const FSoftObjectPath& AssetPath) const { return Entries.Contains(AssetPath); }
+
+	// Returns the loaded Data Asset. If the Data Asset is not resident returns nullptr.
+	UObject* GetObject(const FSoftObjectPath& AssetPath) const
+	{
+		const FEntry* Entry = Entries.Find(AssetPath);
+
+		return Entry ? Entry->Object : nullptr;
+	}
+
+	// Returns the loaded Data Asset. If the Data Asset is not resident or is not of the requested class returns nullptr.
+	template<typename T>
+	T* GetObject(const TSoftObjectPtr<T>& PrimaryDataAsset) const
+	{
+		return Cast<T>(GetObject(PrimaryDataAsset.ToSoftObjectPath()));
+	}
+
+	const TMap<FSoftObjectPath, FEntry>& GetEntries() const { return Entries; }
+
+	// Returns the generation of the stored data the snapshot was built from.
+	int32 GetGeneration() const { return Generation; }
+
+	// Returns the number of resident Data Assets.
+	int32 Num() const { return Entries.Num(); }
+
+	//~Reference counting of TRefCountPtr. Thread safe.
+	uint32 AddRef() const { return uint32(NumRefs.fetch_add(1) + 1); }
+
+	uint32 Release() const
+	{
+		int32 NewNumRefs = NumRefs.fetch_sub(1) - 1;
+
+		if (NewNumRefs == 0)
+		{
+			delete this;
+		}
+
+		return uint32(NewNumRefs);
+	}
+
+	uint32 GetRefCount() const { return uint32(NumRefs.load()); }
+	//~End reference counting
+
+private:
+	const TMap<FSoftObjectPath, FEntry> Entries;
+
+	const int32 Generation = 0;
+
+	mutable std::atomic<int32> NumRefs = 0;
+};
+
+// Keeps the snapshot and its objects valid. Can be copied and released on any thread.
+using FResidencySnapshotRefADAM = TRefCountPtr<const FResidencySnapshotADAM>;
+
+/**
+ * Publication point of the residency snapshots, shared between the game thread and worker threads.
+ *
+ * RCU-style: the game thread replaces the current snapshot with an atomic exchange, readers take a reference
+ * to the current snapshot without locks. A replaced snapshot can be freed once no reader is in the middle
+ * of taking a reference and only the publisher holds it.
+ */
+class ASYNCDATAASSETMANAGER_API FResidencySnapshotChannelADAM
+{
+public:
+	~FResidencySnapshotChannelADAM();
+
+	// Returns the latest published snapshot. Never blocks, can be called from any thread. The reference is empty if nothing is published.
+	FResidencySnapshotRefADAM Acquire() const;
+
+	/**
+	 * Replace the current snapshot. Game thread only.
+	 *
+	 * @param Snapshot New snapshot, or nullptr to withdraw the current one.
+	 * @return The replaced snapshot.
+	 */
+	FResidencySnapshotRefADAM Publish(FResidencySnapshotRefADAM Snapshot);
+
+	// Checks whether no reader is taking a reference right now. Snapshots replaced before the check can no longer gain readers.
+	bool IsQuiescent() const { return NumAcquiring.load() == 0; }
+
+private:
+	// Holds a reference to the current snapshot
+	std::atomic<const FResidencySnapshotADAM*> Current = nullptr;
+
+	// Readers between loading the current snapshot and taking its reference
+	mutable std::atomic<int32> NumAcquiring = 0;
+};
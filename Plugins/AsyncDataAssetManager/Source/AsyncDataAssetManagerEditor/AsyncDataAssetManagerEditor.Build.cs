@@ -0,0 +1,32 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class AsyncDataAssetManagerEditor : ModuleRules
+{
+	public AsyncDataAssetManagerEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+			
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"DeveloperSettings",
+				"GameplayTags",
+				"AssetRegistry",
+				"Projects",
+				"AsyncDataAssetManager",
+			}
+			);
+	}
+}
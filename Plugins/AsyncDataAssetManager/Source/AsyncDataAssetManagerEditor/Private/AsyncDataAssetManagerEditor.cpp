@@ -0,0 +1,5 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "AsyncDataAssetManagerEditor.h"
+
+IMPLEMENT_MODULE(FAsyncDataAssetManagerEditorModule, AsyncDataAssetManagerEditor)
@@ -0,0 +1,362 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "BenchmarkADAMCommandlet.h"
+
+#include "AsyncDataAssetManagerSubsystem.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectGlobals.h"
+
+UBenchmarkADAMCommandlet::UBenchmarkADAMCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBenchmarkADAMCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	TArray<FString> SizeTokens;
+	ParamValues.FindRef(TEXT("Sizes")).ParseIntoArray(SizeTokens, TEXT("+"));
+
+	TArray<int32> Sizes;
+
+	for (const FString& SizeToken : SizeTokens)
+	{
+		Sizes.Add(FMath::Max(FCString::Atoi(*SizeToken), 1));
+	}
+
+	if (Sizes.IsEmpty())
+	{
+		Sizes = { 100, 1000, 10000 };
+	}
+
+	const FString* WidthValue = ParamValues.Find(TEXT("Width"));
+	const FString* DepthValue = ParamValues.Find(TEXT("Depth"));
+	const FString* IterationsValue = ParamValues.Find(TEXT("Iterations"));
+
+	int32 Width = WidthValue ? FMath::Max(FCString::Atoi(**WidthValue), 1) : 4;
+	int32 Depth = DepthValue ? FMath::Max(FCString::Atoi(**DepthValue), 0) : 3;
+	int32 Iterations = IterationsValue ? FMath::Max(FCString::Atoi(**IterationsValue), 1) : 5;
+
+	// Without saved packages the loads find the Data Assets in memory and no IO is measured
+	bool bInMemory = Switches.Contains(TEXT("InMemory"));
+
+	FString OutputFile = ParamValues.FindRef(TEXT("Output"));
+
+	if (OutputFile.IsEmpty())
+	{
+		OutputFile = FPaths::ProjectSavedDir() / TEXT("ADAM/BenchmarkADAM.csv");
+	}
+
+	FString VersionName = TEXT("Unknown");
+
+	if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("AsyncDataAssetManager")))
+	{
+		VersionName = Plugin->GetDescriptor().VersionName;
+	}
+
+	// The subsystem is created by a standalone game instance, as in a running game
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone();
+
+	UAsyncDataAssetManagerSubsystem* SubsystemADAM = GameInstance->GetSubsystem<UAsyncDataAssetManagerSubsystem>();
+
+	if (!SubsystemADAM)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ADAM (Benchmark): The ADAM subsystem can't be created."));
+
+		GameInstance->Shutdown();
+
+		return 1;
+	}
+
+	FName Tag(TEXT("ADAMBenchmark"));
+	FTagContainerADAM UnloadTags;
+	UnloadTags.TagName = Tag;
+
+	TArray<FString> Rows;
+	bool bHasTimedOut = false;
+
+	// Median, minimum and maximum of the samples. The cost per operation is derived from the median.
+	auto AddResult = [&Rows, &VersionName, Width, Depth, Iterations](const TCHAR* CaseName, int32 NumDataAssets, TArray<double>& Samples, int32 NumOperations)
+	{
+		Samples.Sort();
+
+		double MedianMs = Samples[Samples.Num() / 2] * 1000.0;
+		double MinMs = Samples[0] * 1000.0;
+		double MaxMs = Samples.Last() * 1000.0;
+		double PerOperationUs = MedianMs * 1000.0 / FMath::Max(NumOperations, 1);
+
+		Rows.Add(FString::Printf(TEXT("%s,%s,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f"), *VersionName, CaseName, NumDataAssets, Width, Depth, Iterations, MedianMs, MinMs, MaxMs, PerOperationUs));
+
+		UE_LOG(LogTemp, Display, TEXT("ADAM (Benchmark): %s with %d Data Assets: %.3f ms (min %.3f ms, max %.3f ms, %.3f us per operation)."), CaseName, NumDataAssets, MedianMs, MinMs, MaxMs, PerOperationUs);
+	};
+
+	for (int32 NumDataAssets : Sizes)
+	{
+		FBenchmarkGraph Graph = GenerateGraph(NumDataAssets, Width, Depth, !bInMemory);
+
+		// Saved Data Assets are loaded from their packages
+		if (!bInMemory)
+		{
+			ReleaseGraph(Graph);
+		}
+
+		TArray<double> LoadSamples;
+		TArray<double> RecursiveLoadSamples;
+		TArray<double> IndexLookupSamples;
+		TArray<double> ClassLookupSamples;
+		TArray<double> UnloadSamples;
+
+		for (int32 Iteration = 0; Iteration < Iterations && !bHasTimedOut; Iteration++)
+		{
+			// Load throughput of a flat array. Data Assets of the previous load are collected, so they are read again.
+			if (!bInMemory)
+			{
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			}
+
+			double LoadTime = LoadAndWait(SubsystemADAM, Graph.DataAssets, Tag, 0);
+
+			if (LoadTime < 0.0)
+			{
+				bHasTimedOut = true;
+
+				break;
+			}
+
+			LoadSamples.Add(LoadTime);
+
+			// Lookup of each stored Data Asset
+			int32 NumFound = 0;
+			double StartTime = FPlatformTime::Seconds();
+
+			for (const TSoftObjectPtr<UPrimaryDataAsset>& DataAsset : Graph.DataAssets)
+			{
+				NumFound += SubsystemADAM->GetIndexDataADAM(DataAsset) != INDEX_NONE ? 1 : 0;
+			}
+
+			IndexLookupSamples.Add(FPlatformTime::Seconds() - StartTime);
+
+			StartTime = FPlatformTime::Seconds();
+			int32 NumByClass = SubsystemADAM->GetDataByClassADAM(UBenchmarkDataAssetADAM::StaticClass(), Tag, false).Num();
+			ClassLookupSamples.Add(FPlatformTime::Seconds() - StartTime);
+
+			if (NumFound != Graph.DataAssets.Num() || NumByClass != Graph.DataAssets.Num())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ADAM (Benchmark): %d of %d Data Assets are stored after the array load."), NumFound, Graph.DataAssets.Num());
+			}
+
+			// Unload of the whole tag
+			StartTime = FPlatformTime::Seconds();
+			SubsystemADAM->UnloadAllTagsADAM(UnloadTags, true);
+			UnloadSamples.Add(FPlatformTime::Seconds() - StartTime);
+
+			if (!bInMemory)
+			{
+				CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			}
+
+			// Latency of the recursive load from the roots, until the nested data of all levels is stored
+			double RecursiveLoadTime = LoadAndWait(SubsystemADAM, Graph.Roots, Tag, -1);
+
+			if (RecursiveLoadTime < 0.0)
+			{
+				bHasTimedOut = true;
+
+				break;
+			}
+
+			RecursiveLoadSamples.Add(RecursiveLoadTime);
+
+			SubsystemADAM->UnloadAllTagsADAM(UnloadTags, true);
+		}
+
+		ReleaseGraph(Graph);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+		if (!bInMemory)
+		{
+			IFileManager::Get().DeleteDirectory(*GetPackageFolder(), false, true);
+		}
+
+		if (bHasTimedOut)
+		{
+			UE_LOG(LogTemp, Error, TEXT("ADAM (Benchmark): Loading of %d Data Assets has timed out."), NumDataAssets);
+
+			break;
+		}
+
+		// The load cases of unsaved graphs are labelled, so they are not compared with the loads from disk
+		AddResult(bInMemory ? TEXT("LoadArrayADAM_NoIO") : TEXT("LoadArrayADAM"), NumDataAssets, LoadSamples, NumDataAssets);
+		AddResult(bInMemory ? TEXT("RecursiveLoad_NoIO") : TEXT("RecursiveLoad"), NumDataAssets, RecursiveLoadSamples, NumDataAssets);
+		AddResult(TEXT("GetIndexDataADAM"), NumDataAssets, IndexLookupSamples, NumDataAssets);
+		AddResult(TEXT("GetDataByClassADAM"), NumDataAssets, ClassLookupSamples, 1);
+		AddResult(TEXT("UnloadAllTagsADAM"), NumDataAssets, UnloadSamples, NumDataAssets);
+	}
+
+	GameInstance->Shutdown();
+
+	if (Rows.IsEmpty())
+		return 1;
+
+	// Results of all runs are kept in the same file, so plugin versions can be compared
+	FString Content;
+
+	if (!IFileManager::Get().FileExists(*OutputFile))
+	{
+		Content += TEXT("Version,Case,DataAssets,Width,Depth,Iterations,MedianMs,MinMs,MaxMs,PerOperationUs") LINE_TERMINATOR;
+	}
+
+	Content += FString::Join(Rows, LINE_TERMINATOR) + LINE_TERMINATOR;
+
+	if (!FFileHelper::SaveStringToFile(Content, *OutputFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ADAM (Benchmark): Results can't be written to \"%s\"."), *OutputFile);
+
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ADAM (Benchmark): %d results are written to \"%s\"."), Rows.Num(), *OutputFile);
+
+	return bHasTimedOut ? 1 : 0;
+}
+
+UBenchmarkADAMCommandlet::FBenchmarkGraph UBenchmarkADAMCommandlet::GenerateGraph(int32 NumDataAssets, int32 Width, int32 Depth, bool SaveToDisk)
+{
+	static int32 GraphCounter = 0;
+	int32 GraphId = ++GraphCounter;
+
+	FBenchmarkGraph Graph;
+	Graph.DataAssets.Reserve(NumDataAssets);
+
+	TArray<UBenchmarkDataAssetADAM*> Nodes;
+	TArray<int32> NodeDepths;
+	Nodes.Reserve(NumDataAssets);
+	NodeDepths.Reserve(NumDataAssets);
+
+	// Each Data Asset has its own package, as an asset saved in the content folder
+	auto CreateNode = [&Nodes, &NodeDepths, &Graph, GraphId](int32 NodeDepth)
+	{
+		FString AssetName = FString::Printf(TEXT("DA_ADAMBenchmark_%d_%d"), GraphId, Nodes.Num());
+		UPackage* Package = CreatePackage(*(TEXT("/Temp/ADAMBenchmark/") + AssetName));
+
+		UBenchmarkDataAssetADAM* Node = NewObject<UBenchmarkDataAssetADAM>(Package, *AssetName, RF_Public | RF_Standalone);
+		Nodes.Add(Node);
+		NodeDepths.Add(NodeDepth);
+		Graph.DataAssets.Add(TSoftObjectPtr<UPrimaryDataAsset>(Node));
+
+		return Node;
+	};
+
+	while (Nodes.Num() < NumDataAssets)
+	{
+		int32 RootIndex = Nodes.Num();
+		Graph.Roots.Add(TSoftObjectPtr<UPrimaryDataAsset>(CreateNode(0)));
+
+		// Breadth-first, so the last tree is cut at its deepest level
+		for (int32 NodeIndex = RootIndex; NodeIndex < Nodes.Num() && Nodes.Num() < NumDataAssets; NodeIndex++)
+		{
+			if (NodeDepths[NodeIndex] >= Depth)
+				continue;
+
+			for (int32 ChildIndex = 0; ChildIndex < Width && Nodes.Num() < NumDataAssets; ChildIndex++)
+			{
+				UBenchmarkDataAssetADAM* Child = CreateNode(NodeDepths[NodeIndex] + 1);
+				Nodes[NodeIndex]->NestedAssets.Add(TSoftObjectPtr<UPrimaryDataAsset>(Child));
+			}
+		}
+	}
+
+	if (SaveToDisk)
+	{
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.Error = GWarn;
+
+		// Saved after the whole graph is built, so the references to the children are included
+		for (UBenchmarkDataAssetADAM* Node : Nodes)
+		{
+			UPackage* Package = Node->GetPackage();
+			FString PackageFileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+			if (!UPackage::SavePackage(Package, Node, *PackageFileName, SaveArgs))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("ADAM (Benchmark): Package \"%s\" can't be saved, its loads are served from memory."), *Package->GetName());
+			}
+		}
+	}
+
+	return Graph;
+}
+
+void UBenchmarkADAMCommandlet::ReleaseGraph(const FBenchmarkGraph& Graph)
+{
+	for (const TSoftObjectPtr<UPrimaryDataAsset>& DataAsset : Graph.DataAssets)
+	{
+		if (UPrimaryDataAsset* Node = DataAsset.Get())
+		{
+			Node->ClearFlags(RF_Standalone);
+		}
+	}
+}
+
+FString UBenchmarkADAMCommandlet::GetPackageFolder()
+{
+	return FPackageName::LongPackageNameToFilename(TEXT("/Temp/ADAMBenchmark/"));
+}
+
+bool UBenchmarkADAMCommandlet::WaitUntil(TFunctionRef<bool()> Condition, double TimeoutSeconds)
+{
+	double StartTime = FPlatformTime::Seconds();
+	double LastTickTime = StartTime;
+
+	while (!Condition())
+	{
+		double CurrentTime = FPlatformTime::Seconds();
+
+		if (CurrentTime - StartTime > TimeoutSeconds)
+			return false;
+
+		// Completion callbacks, nested data searches and the post-load tick of the subsystem
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		ProcessAsyncLoading(true, false, 0.005);
+		FTSTicker::GetCoreTicker().Tick(float(CurrentTime - LastTickTime));
+
+		LastTickTime = CurrentTime;
+	}
+
+	return true;
+}
+
+double UBenchmarkADAMCommandlet::LoadAndWait(UAsyncDataAssetManagerSubsystem* SubsystemADAM, const TArray<TSoftObjectPtr<UPrimaryDataAsset>>& DataAssets, FName Tag, int32 RecursiveDepthLoading)
+{
+	FTagADAM LoadTag;
+	LoadTag.TagName = Tag;
+
+	TArray<TSoftObjectPtr<UPrimaryDataAsset>> ReturnPrimaryDataAssets;
+
+	double StartTime = FPlatformTime::Seconds();
+	int32 BatchId = SubsystemADAM->LoadArrayADAM(DataAssets, LoadTag, false, RecursiveDepthLoading, ReturnPrimaryDataAssets);
+
+	if (!WaitUntil([SubsystemADAM, BatchId]() { return !SubsystemADAM->IsBatchLoadingADAM(BatchId); }))
+		return -1.0;
+
+	return FPlatformTime::Seconds() - StartTime;
+}
@@ -0,0 +1,86 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "Engine/DataAsset.h"
+
+#include "BenchmarkADAMCommandlet.generated.h"
+
+class UAsyncDataAssetManagerSubsystem;
+
+/**
+ * Synthetic Data Asset of the ADAM benchmark. Each node references its children in the generated graph.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UBenchmarkDataAssetADAM : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TArray<TSoftObjectPtr<UPrimaryDataAsset>> NestedAssets;
+};
+
+/**
+ * Benchmark of the ADAM subsystem on synthetic Data Asset graphs.
+ *
+ * For each size, a forest of Data Assets of the specified width and depth is generated and the subsystem
+ * of a standalone game instance measures array load throughput, recursive load latency, lookup cost of
+ * GetIndexDataADAM and GetDataByClassADAM, and the cost of UnloadAllTagsADAM. The graphs are saved as temporary
+ * packages and collected before each load, so the load cases include reading and deserializing the packages.
+ * With "-InMemory" the graphs are never saved and the load cases, suffixed with "_NoIO", measure only the cost
+ * of the subsystem and the StreamableManager.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=BenchmarkADAM -nullrhi [-Sizes=100+1000+10000] [-Width=4] [-Depth=3] [-Iterations=5] [-InMemory] [-Output=<File>]
+ * Results are appended to "Saved/ADAM/BenchmarkADAM.csv" by default, one row per case, size and plugin version.
+ */
+UCLASS()
+class UBenchmarkADAMCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBenchmarkADAMCommandlet();
+
+	//~UCommandlet
+	virtual int32 Main(const FString& Params) override;
+	//~End UCommandlet
+
+private:
+	struct FBenchmarkGraph
+	{
+		// All generated Data Assets
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> DataAssets;
+
+		// Roots of the trees, the rest is reachable by recursive loading
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> Roots;
+	};
+
+	/**
+	 * Generates a forest of Data Assets. Each tree has the specified width and depth, trees are added until the number of Data Assets is reached.
+	 *
+	 * @param NumDataAssets Number of generated Data Assets.
+	 * @param Width Number of children of each node.
+	 * @param Depth Number of levels below the root.
+	 * @param SaveToDisk If true, each Data Asset is saved to its temporary package, so it can be loaded again after it is collected.
+	 */
+	static FBenchmarkGraph GenerateGraph(int32 NumDataAssets, int32 Width, int32 Depth, bool SaveToDisk);
+
+	// Releases the generated Data Assets, so they are collected by the next garbage collection.
+	static void ReleaseGraph(const FBenchmarkGraph& Graph);
+
+	// Returns the folder of the temporary packages of the benchmark.
+	static FString GetPackageFolder();
+
+	/**
+	 * Ticks the engine until the condition is met.
+	 *
+	 * @return False if the timeout is exceeded.
+	 */
+	static bool WaitUntil(TFunctionRef<bool()> Condition, double TimeoutSeconds = 120.0);
+
+	// Loads the Data Assets with a single array load and waits for it to complete. Returns the elapsed time in seconds.
+	static double LoadAndWait(UAsyncDataAssetManagerSubsystem* SubsystemADAM, const TArray<TSoftObjectPtr<UPrimaryDataAsset>>& DataAssets, FName Tag, int32 RecursiveDepthLoading);
+};
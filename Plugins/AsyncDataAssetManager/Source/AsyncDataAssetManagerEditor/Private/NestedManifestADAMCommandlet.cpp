@@ -0,0 +1,164 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "NestedManifestADAMCommandlet.h"
+
+#include "Engine/DataAsset.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+#include "AsyncDataAssetManagerSubsystem.h"
+#include "AsyncTechnologiesSettings.h"
+#include "NestedManifestADAM.h"
+
+UNestedManifestADAMCommandlet::UNestedManifestADAMCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UNestedManifestADAMCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	TArray<FString> PackagePaths;
+	ParamValues.FindRef(TEXT("Paths")).ParseIntoArray(PackagePaths, TEXT("+"));
+
+	if (PackagePaths.IsEmpty())
+	{
+		PackagePaths.Add(TEXT("/Game"));
+	}
+
+	FString OutputFile = ParamValues.FindRef(TEXT("Output"));
+
+	if (OutputFile.IsEmpty())
+	{
+		OutputFile = FPaths::ProjectContentDir() / GetDefault<UAsyncTechnologiesSettings>()->NestedManifestPathADAM;
+	}
+
+	// Collect the Primary Data Assets of the specified paths
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UPrimaryDataAsset::StaticClass()->GetClassPathName());
+	Filter.bRecursiveClasses = true;
+	Filter.bRecursivePaths = true;
+
+	for (const FString& PackagePath : PackagePaths)
+	{
+		Filter.PackagePaths.Add(FName(*PackagePath));
+	}
+
+	TArray<FAssetData> DataAssets;
+	AssetRegistry.GetAssets(Filter, DataAssets);
+
+	TArray<FSoftObjectPath> PendingPaths;
+	PendingPaths.Reserve(DataAssets.Num());
+
+	for (const FAssetData& AssetData : DataAssets)
+	{
+		PendingPaths.Add(AssetData.GetSoftObjectPath());
+	}
+
+	// Direct nested Data Assets of each Data Asset. Nested Data Assets outside of the specified paths are also scanned.
+	TMap<FSoftObjectPath, TArray<FSoftObjectPath>> NestedGraph;
+	int32 NumLoaded = 0;
+
+	while (!PendingPaths.IsEmpty())
+	{
+		FSoftObjectPath AssetPath = PendingPaths.Pop(EAllowShrinking::No);
+
+		if (NestedGraph.Contains(AssetPath))
+			continue;
+
+		TArray<FSoftObjectPath>& NestedPaths = NestedGraph.Add(AssetPath);
+		UPrimaryDataAsset* DataAsset = Cast<UPrimaryDataAsset>(AssetPath.TryLoad());
+
+		if (!DataAsset)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ADAM (Nested Manifest): Data Asset \"%s\" can't be loaded."), *AssetPath.ToString());
+
+			continue;
+		}
+
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> NestedAssets;
+		UAsyncDataAssetManagerSubsystem::FindNestedAssetsADAM(DataAsset, NestedAssets);
+
+		for (const TSoftObjectPtr<UPrimaryDataAsset>& NestedAsset : NestedAssets)
+		{
+			NestedPaths.Add(NestedAsset.ToSoftObjectPath());
+			PendingPaths.Add(NestedAsset.ToSoftObjectPath());
+		}
+
+		// Loaded Data Assets are not needed after the search
+		if (++NumLoaded % 256 == 0)
+		{
+			CollectGarbage(RF_NoFlags);
+		}
+	}
+
+	// Closure of each Data Asset, the depth of a nested Data Asset is the shortest path from the root
+	FNestedManifestADAM Manifest;
+	int32 NumNestedEntries = 0;
+
+	for (const TPair<FSoftObjectPath, TArray<FSoftObjectPath>>& Node : NestedGraph)
+	{
+		TArray<TPair<FSoftObjectPath, int32>> Closure;
+		TSet<FSoftObjectPath> VisitedPaths;
+		VisitedPaths.Add(Node.Key);
+
+		TArray<FSoftObjectPath> CurrentLevel = Node.Value;
+		int32 Depth = 1;
+
+		while (!CurrentLevel.IsEmpty())
+		{
+			TArray<FSoftObjectPath> NextLevel;
+
+			for (const FSoftObjectPath& NestedPath : CurrentLevel)
+			{
+				bool bIsAlreadyVisited = false;
+				VisitedPaths.Add(NestedPath, &bIsAlreadyVisited);
+
+				if (bIsAlreadyVisited)
+					continue;
+
+				Closure.Emplace(NestedPath, Depth);
+
+				if (const TArray<FSoftObjectPath>* NestedOfNested = NestedGraph.Find(NestedPath))
+				{
+					NextLevel.Append(*NestedOfNested);
+				}
+			}
+
+			CurrentLevel = MoveTemp(NextLevel);
+			Depth++;
+		}
+
+		NumNestedEntries += Closure.Num();
+		Manifest.SetClosure(Node.Key, Closure);
+
+		// The editor compares the saved hashes to find the closures changed after the generation
+		if (TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(Node.Key.GetLongPackageFName()))
+		{
+			Manifest.SetSavedHash(Node.Key, PackageData->GetPackageSavedHash());
+		}
+	}
+
+	if (!Manifest.SaveToFile(OutputFile))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ADAM (Nested Manifest): Manifest can't be written to \"%s\"."), *OutputFile);
+
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ADAM (Nested Manifest): %d Data Assets with %d nested entries are written to \"%s\"."), Manifest.Num(), NumNestedEntries, *OutputFile);
+
+	return 0;
+}
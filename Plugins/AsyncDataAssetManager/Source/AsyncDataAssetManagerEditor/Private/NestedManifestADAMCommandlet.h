@@ -0,0 +1,30 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "NestedManifestADAMCommandlet.generated.h"
+
+/**
+ * Generates the nested dependency manifest of the ADAM subsystem.
+ *
+ * Loads every Primary Data Asset under the specified content paths, searches its nested Primary Data Assets
+ * and writes the closure of each of them with depth annotations.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=NestedManifestADAM [-Paths=/Game/Data+/Game/Items] [-Output=<File>]
+ * By default the whole "/Game" folder is scanned and the manifest is written to the path from the plugin settings.
+ */
+UCLASS()
+class UNestedManifestADAMCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UNestedManifestADAMCommandlet();
+
+	//~UCommandlet
+	virtual int32 Main(const FString& Params) override;
+	//~End UCommandlet
+};
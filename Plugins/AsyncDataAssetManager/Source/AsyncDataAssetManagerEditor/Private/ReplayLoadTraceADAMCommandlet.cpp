@@ -0,0 +1,315 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#include "ReplayLoadTraceADAMCommandlet.h"
+
+#include "AsyncDataAssetManagerSubsystem.h"
+#include "LoadTraceADAM.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+UReplayLoadTraceADAMCommandlet::UReplayLoadTraceADAMCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UReplayLoadTraceADAMCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	FString TraceFile = ParamValues.FindRef(TEXT("Trace"));
+
+	if (TraceFile.IsEmpty())
+	{
+		TraceFile = FPaths::ProjectSavedDir() / TEXT("ADAM/LoadTraceADAM.bin");
+	}
+
+	const FString* SpeedValue = ParamValues.Find(TEXT("Speed"));
+	double Speed = SpeedValue ? FMath::Max(FCString::Atod(**SpeedValue), 0.0) : 1.0;
+
+	FString OutputFile = ParamValues.FindRef(TEXT("Output"));
+
+	if (OutputFile.IsEmpty())
+	{
+		OutputFile = FPaths::ProjectSavedDir() / TEXT("ADAM/ReplayLoadTraceADAM.csv");
+	}
+
+	FLoadTraceADAM Trace;
+
+	if (!Trace.LoadFromFile(TraceFile))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ADAM (Replay): Load trace \"%s\" can't be loaded."), *TraceFile);
+
+		return 1;
+	}
+
+	FString VersionName = TEXT("Unknown");
+
+	if (TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("AsyncDataAssetManager")))
+	{
+		VersionName = Plugin->GetDescriptor().VersionName;
+	}
+
+	// The subsystem is created by a standalone game instance, as in a running game
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone();
+
+	UAsyncDataAssetManagerSubsystem* SubsystemADAM = GameInstance->GetSubsystem<UAsyncDataAssetManagerSubsystem>();
+
+	if (!SubsystemADAM)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ADAM (Replay): The ADAM subsystem can't be created."));
+
+		GameInstance->Shutdown();
+
+		return 1;
+	}
+
+	// The replayed session must not be recorded over the trace
+	if (SubsystemADAM->IsLoadTraceRecordingADAM())
+	{
+		SubsystemADAM->StopLoadTraceADAM(FPaths::ProjectSavedDir() / TEXT("ADAM/ReplayedLoadTraceADAM.bin"));
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ADAM (Replay): Replaying %d events of \"%s\"."), Trace.Num(), *TraceFile);
+
+	double StartTime = FPlatformTime::Seconds();
+	double LastTickTime = StartTime;
+
+	for (const FLoadTraceEventADAM& Event : Trace.GetEvents())
+	{
+		// The recorded pauses between the calls are kept, so the loads overlap as in the session
+		if (Speed > 0.0)
+		{
+			double EventTime = StartTime + Event.Time / Speed;
+
+			while (FPlatformTime::Seconds() < EventTime)
+			{
+				TickReplay(SubsystemADAM, LastTickTime);
+			}
+		}
+
+		ReplayEvent(SubsystemADAM, Trace, Event);
+		TickReplay(SubsystemADAM, LastTickTime);
+	}
+
+	// Loads of the last events
+	constexpr double TimeoutSeconds = 120.0;
+	double DrainStartTime = FPlatformTime::Seconds();
+
+	while (!PendingLoads.IsEmpty() && FPlatformTime::Seconds() - DrainStartTime < TimeoutSeconds)
+	{
+		TickReplay(SubsystemADAM, LastTickTime);
+	}
+
+	double Duration = FPlatformTime::Seconds() - StartTime;
+	bool bHasTimedOut = !PendingLoads.IsEmpty();
+
+	if (bHasTimedOut)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ADAM (Replay): %d Data Assets are not loaded in %.0f seconds after the last event."), PendingLoads.Num(), TimeoutSeconds);
+	}
+
+	SubsystemADAM->UnloadAllADAM(true);
+	GameInstance->Shutdown();
+
+	double P50Ms = GetLatencyPercentileMs(0.5);
+	double P90Ms = GetLatencyPercentileMs(0.9);
+	double P99Ms = GetLatencyPercentileMs(0.99);
+	double MaxMs = GetLatencyPercentileMs(1.0);
+	double PeakResidentMB = double(Stats.PeakResidentSize) / (1024.0 * 1024.0);
+	double PeakUsedPhysicalMB = double(Stats.PeakUsedPhysical) / (1024.0 * 1024.0);
+
+	UE_LOG(LogTemp, Display, TEXT("ADAM (Replay): %d events in %.2f s. %d requests, %d duplicates in flight, %d duplicates stored."), Trace.Num(), Duration, Stats.NumRequests, Stats.NumDuplicatesInFlight, Stats.NumDuplicatesStored);
+	UE_LOG(LogTemp, Display, TEXT("ADAM (Replay): Latency of %d loads: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms."), Stats.Latencies.Num(), P50Ms, P90Ms, P99Ms, MaxMs);
+	UE_LOG(LogTemp, Display, TEXT("ADAM (Replay): Peak resident size %.2f MB, peak used physical memory of the process %.2f MB."), PeakResidentMB, PeakUsedPhysicalMB);
+
+	// Results of all runs are kept in the same file, so plugin versions can be compared
+	FString Content;
+
+	if (!IFileManager::Get().FileExists(*OutputFile))
+	{
+		Content += TEXT("Version,Trace,Events,Speed,DurationS,Requests,DuplicatesInFlight,DuplicatesStored,Loads,P50Ms,P90Ms,P99Ms,MaxMs,PeakResidentMB,PeakUsedPhysicalMB") LINE_TERMINATOR;
+	}
+
+	Content += FString::Printf(TEXT("%s,%s,%d,%.2f,%.3f,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%.3f,%.3f"),
+		*VersionName,
+		*FPaths::GetCleanFilename(TraceFile),
+		Trace.Num(),
+		Speed,
+		Duration,
+		Stats.NumRequests,
+		Stats.NumDuplicatesInFlight,
+		Stats.NumDuplicatesStored,
+		Stats.Latencies.Num(),
+		P50Ms,
+		P90Ms,
+		P99Ms,
+		MaxMs,
+		PeakResidentMB,
+		PeakUsedPhysicalMB) + LINE_TERMINATOR;
+
+	if (!FFileHelper::SaveStringToFile(Content, *OutputFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Error, TEXT("ADAM (Replay): Results can't be written to \"%s\"."), *OutputFile);
+
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("ADAM (Replay): Results are written to \"%s\"."), *OutputFile);
+
+	return bHasTimedOut ? 1 : 0;
+}
+
+void UReplayLoadTraceADAMCommandlet::ReplayEvent(UAsyncDataAssetManagerSubsystem* SubsystemADAM, const FLoadTraceADAM& Trace, const FLoadTraceEventADAM& Event)
+{
+	TArray<TSoftObjectPtr<UPrimaryDataAsset>> DataAssets;
+	DataAssets.Reserve(Event.PathIds.Num());
+
+	for (int32 PathId : Event.PathIds)
+	{
+		DataAssets.Add(TSoftObjectPtr<UPrimaryDataAsset>(Trace.GetPath(PathId)));
+	}
+
+	bool bIsLoad = Event.Type == ELoadTraceEventADAM::Load || Event.Type == ELoadTraceEventADAM::LoadArray || Event.Type == ELoadTraceEventADAM::FastLoad;
+
+	if (bIsLoad)
+	{
+		TSet<FSoftObjectPath> UniquePaths;
+
+		for (const TSoftObjectPtr<UPrimaryDataAsset>& DataAsset : DataAssets)
+		{
+			bool bIsAlreadyCounted = false;
+			UniquePaths.Add(DataAsset.ToSoftObjectPath(), &bIsAlreadyCounted);
+
+			if (bIsAlreadyCounted)
+				continue;
+
+			Stats.NumRequests++;
+
+			// A stored Data Asset also has a slot while it is loading
+			if (SubsystemADAM->IsLoadingADAM(DataAsset))
+			{
+				Stats.NumDuplicatesInFlight++;
+			}
+			else if (SubsystemADAM->GetIndexDataADAM(DataAsset) != INDEX_NONE)
+			{
+				Stats.NumDuplicatesStored++;
+			}
+		}
+	}
+
+	FTagADAM Tag;
+	Tag.TagName = Event.TagIds.IsEmpty() ? NAME_None : Trace.GetTag(Event.TagIds[0]);
+
+	switch (Event.Type)
+	{
+	case ELoadTraceEventADAM::Load:
+	{
+		TSoftObjectPtr<UPrimaryDataAsset> ReturnPrimaryDataAsset;
+		SubsystemADAM->LoadADAM(DataAssets[0], Tag, Event.RecursiveDepthLoading, ReturnPrimaryDataAsset, Event.Priority);
+		break;
+	}
+	case ELoadTraceEventADAM::LoadArray:
+	{
+		TArray<TSoftObjectPtr<UPrimaryDataAsset>> ReturnPrimaryDataAssets;
+		SubsystemADAM->LoadArrayADAM(DataAssets, Tag, Event.Flag, Event.RecursiveDepthLoading, ReturnPrimaryDataAssets, Event.Priority);
+		break;
+	}
+	case ELoadTraceEventADAM::FastLoad:
+	{
+		TSoftObjectPtr<UPrimaryDataAsset> ReturnPrimaryDataAsset;
+		SubsystemADAM->FastLoadADAM(DataAssets[0], ReturnPrimaryDataAsset);
+		break;
+	}
+	case ELoadTraceEventADAM::Unload:
+	{
+		SubsystemADAM->UnloadADAM(DataAssets[0], Event.Flag);
+		break;
+	}
+	case ELoadTraceEventADAM::UnloadAll:
+	{
+		SubsystemADAM->UnloadAllADAM(Event.Flag);
+		break;
+	}
+	case ELoadTraceEventADAM::UnloadAllTags:
+	{
+		// The recorded tags are already resolved, including the child gameplay tags
+		FTagContainerADAM Tags;
+
+		for (int32 TagId : Event.TagIds)
+		{
+			Tags.TagNameContainer.Add(Trace.GetTag(TagId));
+		}
+
+		SubsystemADAM->UnloadAllTagsADAM(Tags, Event.Flag);
+		break;
+	}
+	}
+
+	// Fast loads are not stored, their latency is not tracked by the subsystem
+	if (Event.Type != ELoadTraceEventADAM::Load && Event.Type != ELoadTraceEventADAM::LoadArray)
+		return;
+
+	double RequestTime = FPlatformTime::Seconds();
+
+	for (const TSoftObjectPtr<UPrimaryDataAsset>& DataAsset : DataAssets)
+	{
+		if (SubsystemADAM->IsLoadingADAM(DataAsset))
+		{
+			PendingLoads.FindOrAdd(DataAsset.ToSoftObjectPath(), RequestTime);
+		}
+	}
+}
+
+void UReplayLoadTraceADAMCommandlet::TickReplay(UAsyncDataAssetManagerSubsystem* SubsystemADAM, double& LastTickTime)
+{
+	double CurrentTime = FPlatformTime::Seconds();
+
+	// Completion callbacks, nested data searches and the post-load tick of the subsystem
+	FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	ProcessAsyncLoading(true, false, 0.005);
+	FTSTicker::GetCoreTicker().Tick(float(CurrentTime - LastTickTime));
+
+	LastTickTime = CurrentTime;
+
+	double CompletionTime = FPlatformTime::Seconds();
+
+	for (TMap<FSoftObjectPath, double>::TIterator It = PendingLoads.CreateIterator(); It; ++It)
+	{
+		if (SubsystemADAM->IsLoadingADAM(TSoftObjectPtr<UPrimaryDataAsset>(It.Key())))
+			continue;
+
+		Stats.Latencies.Add(CompletionTime - It.Value());
+		It.RemoveCurrent();
+	}
+
+	Stats.PeakResidentSize = FMath::Max(Stats.PeakResidentSize, SubsystemADAM->GetTotalResidentSizeADAM());
+	Stats.PeakUsedPhysical = FMath::Max(Stats.PeakUsedPhysical, uint64(FPlatformMemory::GetStats().UsedPhysical));
+}
+
+double UReplayLoadTraceADAMCommandlet::GetLatencyPercentileMs(double Percentile) const
+{
+	if (Stats.Latencies.IsEmpty())
+		return 0.0;
+
+	TArray<double> SortedLatencies = Stats.Latencies;
+	SortedLatencies.Sort();
+
+	int32 LatencyIndex = FMath::Clamp(FMath::CeilToInt32(Percentile * SortedLatencies.Num()) - 1, 0, SortedLatencies.Num() - 1);
+
+	return SortedLatencies[LatencyIndex] * 1000.0;
+}
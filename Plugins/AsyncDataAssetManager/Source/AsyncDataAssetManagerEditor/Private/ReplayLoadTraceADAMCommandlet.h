@@ -0,0 +1,70 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "ReplayLoadTraceADAMCommandlet.generated.h"
+
+class UAsyncDataAssetManagerSubsystem;
+class FLoadTraceADAM;
+struct FLoadTraceEventADAM;
+
+/**
+ * Replay of a load trace recorded by the ADAM subsystem.
+ *
+ * The loads and unloads of the trace are issued against the subsystem of a standalone game instance of the current
+ * build, at their recorded time or as fast as possible. The replay reports the latency of each requested Data Asset,
+ * the peak resident size of the subsystem and of the process, and the number of duplicate requests, that is the loads
+ * of Data Assets that are already being loaded or are already stored.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=ReplayLoadTraceADAM -nullrhi [-Trace=<File>] [-Speed=1.0] [-Output=<File>]
+ * The trace is read from "Saved/ADAM/LoadTraceADAM.bin" by default. A speed of '0' replays the events without waiting.
+ * Results are appended to "Saved/ADAM/ReplayLoadTraceADAM.csv" by default, one row per replay and plugin version.
+ */
+UCLASS()
+class UReplayLoadTraceADAMCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UReplayLoadTraceADAMCommandlet();
+
+	//~UCommandlet
+	virtual int32 Main(const FString& Params) override;
+	//~End UCommandlet
+
+private:
+	struct FReplayStats
+	{
+		int32 NumRequests = 0;
+
+		// Requests of Data Assets that are already being loaded
+		int32 NumDuplicatesInFlight = 0;
+
+		// Requests of Data Assets that are already stored
+		int32 NumDuplicatesStored = 0;
+
+		// Time from the request to the end of the loading of each Data Asset in seconds
+		TArray<double> Latencies;
+
+		int64 PeakResidentSize = 0;
+
+		uint64 PeakUsedPhysical = 0;
+	};
+
+	// Requested Data Assets that are being loaded (asset path -> request time).
+	TMap<FSoftObjectPath, double> PendingLoads;
+
+	FReplayStats Stats;
+
+	// Issues the recorded call and counts the duplicate requests.
+	void ReplayEvent(UAsyncDataAssetManagerSubsystem* SubsystemADAM, const FLoadTraceADAM& Trace, const FLoadTraceEventADAM& Event);
+
+	// Ticks the engine once, collects the latency of the completed loads and the peak memory.
+	void TickReplay(UAsyncDataAssetManagerSubsystem* SubsystemADAM, double& LastTickTime);
+
+	// Returns the latency at the percentile in milliseconds.
+	double GetLatencyPercentileMs(double Percentile) const;
+};
@@ -0,0 +1,14 @@
+// Pavel Gornostaev <https://github.com/Pavreally>
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+/**
+ * Editor tools of the ADAM subsystem: the nested manifest, benchmark and load trace replay commandlets.
+ * Kept out of the runtime module, so they are not shipped with the game.
+ */
+class FAsyncDataAssetManagerEditorModule : public IModuleInterface
+{
+};